@@ -0,0 +1,283 @@
+/**************************************************************************************************
+ * @file BatchWriter.hpp
+ *
+ * @brief Gathers many strings into one output call.
+ *
+ * This file contains the definition of BatchWriter, which queues strings and writes
+ * them all at once: with a single writev() per batch when writing to a file
+ * descriptor, or with one write() per queued piece when writing to an ostream.
+ * High-volume output paths thereby make one system call for hundreds of strings,
+ * without first concatenating them into a temporary buffer.
+ *
+ **************************************************************************************************/
+
+#ifndef BATCH_WRITER_HPP
+#define BATCH_WRITER_HPP
+
+#include "StringView.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace UserDefined
+{
+    /**
+     * @class BatchWriter
+     * @brief Queues strings and writes them out in batches.
+     *
+     * Long strings are not copied: the writer keeps a pointer to their characters, so
+     * everything passed to add() must stay valid and unchanged until the next flush().
+     * Short strings are copied into a staging buffer, where consecutive ones merge into
+     * a single piece. The writer flushes by itself when the staging buffer or the piece
+     * list is full, and when it is destroyed.
+     *
+     * The writer is not thread safe.
+     */
+    class BatchWriter
+    {
+    public:
+
+        // #region Constructors/Destruction
+
+        /**
+         * @brief Constructs a writer for a file descriptor, flushed with writev().
+         *
+         * @param fileDescriptor The descriptor to write to; it is not closed by the writer.
+         */
+        explicit BatchWriter(int fileDescriptor)
+            : BatchWriter(fileDescriptor, nullptr)
+        {
+        }
+
+        /**
+         * @brief Constructs a writer for an output stream, flushed with one write() per piece.
+         *
+         * @param outputStream The stream to write to; it must outlive the writer.
+         */
+        explicit BatchWriter(std::ostream& outputStream)
+            : BatchWriter(-1, &outputStream)
+        {
+        }
+
+        BatchWriter(const BatchWriter&) = delete;
+        BatchWriter& operator=(const BatchWriter&) = delete;
+
+        /**
+         * @brief Destroy the BatchWriter object, writing whatever is still queued.
+         */
+        ~BatchWriter()
+        {
+            flush();
+        }
+
+        // #endregion
+
+        // #region Public Methods
+
+        /**
+         * @brief Queues characters to be written.
+         *
+         * @param piece The characters to write (a String, C-string or view).
+         * @return A reference to the writer.
+         */
+        BatchWriter& add(StringView piece)
+        {
+            if (piece.empty())
+            {
+                return *this;
+            }
+
+            if (piece.length() <= _copyThreshold)
+            {
+                if (_stagingUsed + piece.length() > _stagingSize)
+                {
+                    flush();
+                }
+                if (_stagingUsed + piece.length() <= _stagingSize)
+                {
+                    _stage(piece);
+                    return *this;
+                }
+                // A failed flush still refers to the staging buffer; fall back to referencing the piece.
+            }
+
+            _pieces.push_back(_makePiece(piece.data(), piece.length()));
+            _pendingBytes += piece.length();
+
+            if (_pieces.size() >= _maxPieces)
+            {
+                flush();
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Queues characters to be written.
+         *
+         * @param piece The characters to write.
+         * @return A reference to the writer.
+         */
+        BatchWriter& operator<<(StringView piece)
+        {
+            return add(piece);
+        }
+
+        /**
+         * @brief Writes everything queued so far.
+         *
+         * Partial writes and interrupted calls are retried. If writing fails (for example
+         * with EAGAIN on a non-blocking descriptor), the unwritten part stays queued for the
+         * next flush() and errno tells why. A failing stream loses the queued characters,
+         * as there is no way to tell how many were written.
+         *
+         * @return true if everything was written, false on error.
+         */
+        bool flush()
+        {
+            std::size_t index = 0;
+
+            while (index < _pieces.size())
+            {
+                if (_outputStream)
+                {
+                    for (; index < _pieces.size(); ++index)
+                    {
+                        _outputStream->write(static_cast<const char*>(_pieces[index].iov_base), static_cast<std::streamsize>(_pieces[index].iov_len));
+                    }
+                    if (!*_outputStream)
+                    {
+                        _reset();
+                        return false;
+                    }
+                    break;
+                }
+
+                std::size_t pieceCount = _pieces.size() - index;
+                if (pieceCount > _maxPieces)
+                {
+                    pieceCount = _maxPieces;
+                }
+                ssize_t written = ::writev(_fileDescriptor, &_pieces[index], static_cast<int>(pieceCount));
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    _pieces.erase(_pieces.begin(), _pieces.begin() + static_cast<std::ptrdiff_t>(index));
+                    return false;
+                }
+
+                // Skip the pieces that were written completely and trim the one written partially.
+                std::size_t remaining = static_cast<std::size_t>(written);
+                _pendingBytes -= remaining;
+                while (remaining > 0)
+                {
+                    iovec& piece = _pieces[index];
+                    if (remaining >= piece.iov_len)
+                    {
+                        remaining -= piece.iov_len;
+                        index++;
+                    }
+                    else
+                    {
+                        piece.iov_base = static_cast<char*>(piece.iov_base) + remaining;
+                        piece.iov_len -= remaining;
+                        remaining = 0;
+                    }
+                }
+            }
+
+            _reset();
+            return true;
+        }
+
+        /**
+         * @brief Gets the number of characters queued and not written yet.
+         *
+         * @return The number of pending characters.
+         */
+        std::size_t pendingBytes() const
+        {
+            return _pendingBytes;
+        }
+
+        // #endregion
+
+    private:
+#ifdef IOV_MAX
+        static constexpr std::size_t _maxPieces = IOV_MAX;      ///< The most pieces one writev() call accepts.
+#else
+        static constexpr std::size_t _maxPieces = 1024;         ///< The most pieces one writev() call accepts.
+#endif
+        static constexpr std::size_t _stagingSize = 64 * 1024;  ///< The size of the buffer short strings are copied to.
+        static constexpr std::size_t _copyThreshold = 256;      ///< Strings up to this length are copied.
+
+        BatchWriter(int fileDescriptor, std::ostream* outputStream)
+            : _fileDescriptor(fileDescriptor)
+            , _outputStream(outputStream)
+            , _staging(new char[_stagingSize])
+            , _stagingUsed(0)
+            , _pendingBytes(0)
+        {
+            _pieces.reserve(_maxPieces);
+        }
+
+        static iovec _makePiece(const char* data, std::size_t length)
+        {
+            iovec piece;
+            piece.iov_base = const_cast<char*>(data);
+            piece.iov_len = length;
+            return piece;
+        }
+
+        /**
+         * @brief Copies a short piece into the staging buffer, merging it with the previous piece if they are adjacent.
+         */
+        void _stage(StringView piece)
+        {
+            char* destination = _staging.get() + _stagingUsed;
+            std::memcpy(destination, piece.data(), piece.length());
+            _stagingUsed += piece.length();
+            _pendingBytes += piece.length();
+
+            if (!_pieces.empty() && static_cast<char*>(_pieces.back().iov_base) + _pieces.back().iov_len == destination)
+            {
+                _pieces.back().iov_len += piece.length();
+                return;
+            }
+
+            _pieces.push_back(_makePiece(destination, piece.length()));
+            if (_pieces.size() >= _maxPieces)
+            {
+                flush();
+            }
+        }
+
+        /**
+         * @brief Forgets all queued pieces and empties the staging buffer.
+         */
+        void _reset()
+        {
+            _pieces.clear();
+            _stagingUsed = 0;
+            _pendingBytes = 0;
+        }
+
+        int _fileDescriptor;                    ///< The descriptor to write to (unused for streams).
+        std::ostream* _outputStream;            ///< The stream to write to, or nullptr for a descriptor.
+        std::vector<iovec> _pieces;             ///< The queued pieces, in order.
+        std::unique_ptr<char[]> _staging;       ///< Holds copies of short strings.
+        std::size_t _stagingUsed;               ///< The number of bytes used in the staging buffer.
+        std::size_t _pendingBytes;              ///< The number of characters queued.
+    };
+}
+
+#endif // BATCH_WRITER_HPP
@@ -0,0 +1,276 @@
+/**************************************************************************************************
+ * @file BenchCompare.cpp
+ *
+ * @brief This file is used to benchmark UserDefined::String side by side with std::string.
+ *
+ * Each operation is measured for both classes over a range of string lengths, reporting the
+ * time, the number of heap allocations and the number of bytes allocated per operation. The
+ * results are printed as a table, or as JSON with --json so that runs can be stored and
+ * compared to catch regressions.
+ *
+ * Usage: ./BenchCompare [--json]
+ **************************************************************************************************/
+
+#include "String.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::size_t allocationCount = 0;    ///< Number of calls to the global operator new.
+    std::size_t allocatedBytes = 0;     ///< Number of bytes requested from the global operator new.
+
+    /**
+     * @struct Result
+     * @brief The cost of one operation, per call.
+     */
+    struct Result
+    {
+        const char* operation;          ///< What was measured.
+        const char* implementation;     ///< "std::string" or "String".
+        std::size_t length;             ///< The length of the strings involved.
+        double nanoseconds;             ///< Time per operation.
+        double allocations;             ///< Heap allocations per operation.
+        double bytes;                   ///< Bytes allocated per operation.
+    };
+
+    /**
+     * @brief Prevents the compiler from optimizing away a benchmarked value.
+     */
+    template <typename T>
+    void doNotOptimize(const T& value)
+    {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    /**
+     * @brief Runs an operation repeatedly and records its cost.
+     *
+     * @param results The results to append to.
+     * @param operationName The name of the operation.
+     * @param implementation The name of the string class.
+     * @param length The length of the strings involved.
+     * @param operation The operation to measure.
+     */
+    template <typename Operation>
+    void measure(std::vector<Result>& results, const char* operationName, const char* implementation, std::size_t length, Operation operation)
+    {
+        // Enough iterations for about 64 MB of characters, but at least a few thousand.
+        std::size_t iterations = std::max<std::size_t>(2000, (std::size_t(64) << 20) / (length + 64));
+
+        operation();
+        std::size_t allocationsBefore = allocationCount;
+        std::size_t bytesBefore = allocatedBytes;
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            operation();
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        results.push_back(Result{ operationName, implementation, length,
+                                  static_cast<double>(elapsed) / iterations,
+                                  static_cast<double>(allocationCount - allocationsBefore) / iterations,
+                                  static_cast<double>(allocatedBytes - bytesBefore) / iterations });
+    }
+
+    bool readLine(std::istream& input, std::string& line)
+    {
+        return static_cast<bool>(std::getline(input, line));
+    }
+
+    bool readLine(std::istream& input, UserDefined::String& line)
+    {
+        return static_cast<bool>(input >> line);
+    }
+
+    /**
+     * @brief Measures every operation for one string class and one length.
+     *
+     * @tparam StringType std::string or UserDefined::String.
+     * @param results The results to append to.
+     * @param implementation The name of the string class.
+     * @param length The length of the strings.
+     */
+    template <typename StringType>
+    void measureOperations(std::vector<Result>& results, const char* implementation, std::size_t length)
+    {
+        const std::string characters(length, 'x');
+        const char* text = characters.c_str();
+        const StringType source(text);
+        const StringType equal(text);
+        StringType target;
+
+        measure(results, "construct from C-string", implementation, length, [&]() {
+            StringType s(text);
+            doNotOptimize(s);
+        });
+        measure(results, "copy construct", implementation, length, [&]() {
+            StringType s(source);
+            doNotOptimize(s);
+        });
+        measure(results, "move construct", implementation, length, [&]() {
+            StringType moved(source);
+            StringType s(std::move(moved));
+            doNotOptimize(s);
+        });
+        measure(results, "copy assign (reused buffer)", implementation, length, [&]() {
+            target = source;
+            doNotOptimize(target);
+        });
+        measure(results, "append characters", implementation, length, [&]() {
+            StringType s;
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                s.push_back('x');
+            }
+            doNotOptimize(s);
+        });
+        measure(results, "concatenate a + b + c", implementation, length, [&]() {
+            StringType s = source + source + source;
+            doNotOptimize(s);
+        });
+        measure(results, "compare equal", implementation, length, [&]() {
+            bool isEqual = source == equal;
+            doNotOptimize(isEqual);
+        });
+        measure(results, "find missing character", implementation, length, [&]() {
+            std::size_t position = source.find('y');
+            doNotOptimize(position);
+        });
+
+        std::ostringstream output;
+        measure(results, "write to ostream", implementation, length, [&]() {
+            output.seekp(0);
+            output << source;
+            doNotOptimize(output);
+        });
+
+        std::string lines;
+        for (std::size_t i = 0; i < 64; ++i)
+        {
+            lines += characters + '\n';
+        }
+        std::istringstream input(lines);
+        StringType line;
+        measure(results, "read line from istream", implementation, length, [&]() {
+            if (!readLine(input, line))
+            {
+                input.clear();
+                input.seekg(0);
+                readLine(input, line);
+            }
+            doNotOptimize(line);
+        });
+    }
+
+    /**
+     * @brief Prints the results as a table, std::string and String side by side.
+     */
+    void printTable(const std::vector<Result>& results)
+    {
+        std::printf("%-28s %8s | %12s %8s %10s | %12s %8s %10s | %7s\n", "operation", "length",
+                    "std ns/op", "allocs", "bytes", "String ns/op", "allocs", "bytes", "speedup");
+
+        for (const Result& stdResult : results)
+        {
+            if (std::strcmp(stdResult.implementation, "std::string") != 0)
+            {
+                continue;
+            }
+            for (const Result& result : results)
+            {
+                if (std::strcmp(result.implementation, "String") == 0 && result.length == stdResult.length && std::strcmp(result.operation, stdResult.operation) == 0)
+                {
+                    std::printf("%-28s %8zu | %12.2f %8.2f %10.1f | %12.2f %8.2f %10.1f | %6.2fx\n", stdResult.operation, stdResult.length,
+                                stdResult.nanoseconds, stdResult.allocations, stdResult.bytes,
+                                result.nanoseconds, result.allocations, result.bytes, stdResult.nanoseconds / result.nanoseconds);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Prints the results as a JSON array of objects.
+     */
+    void printJson(const std::vector<Result>& results)
+    {
+        std::printf("[\n");
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& result = results[i];
+            std::printf("  {\"operation\": \"%s\", \"implementation\": \"%s\", \"length\": %zu, \"ns_per_op\": %.3f, \"allocs_per_op\": %.3f, \"bytes_per_op\": %.1f}%s\n",
+                        result.operation, result.implementation, result.length, result.nanoseconds, result.allocations, result.bytes,
+                        i + 1 < results.size() ? "," : "");
+        }
+        std::printf("]\n");
+    }
+}
+
+// The replacement functions are kept out of line: inlined into library code, GCC 12 matches the
+// malloc() and free() inside them against each other and issues spurious -Wmismatched-new-delete.
+__attribute__((noinline)) void* operator new(std::size_t size)
+{
+    ++allocationCount;
+    allocatedBytes += size;
+    if (void* memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+__attribute__((noinline)) void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main(int argc, char* argv[])
+{
+    bool json = argc > 1 && std::strcmp(argv[1], "--json") == 0;
+
+    std::vector<Result> results;
+    for (std::size_t length : { std::size_t(8), std::size_t(23), std::size_t(24), std::size_t(100), std::size_t(1000), std::size_t(100000) })
+    {
+        measureOperations<std::string>(results, "std::string", length);
+        measureOperations<UserDefined::String>(results, "String", length);
+    }
+
+    if (json)
+    {
+        printJson(results);
+    }
+    else
+    {
+        printTable(results);
+    }
+    return 0;
+}
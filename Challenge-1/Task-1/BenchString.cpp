@@ -0,0 +1,962 @@
+/**************************************************************************************************
+ * @file BenchString.cpp
+ *
+ * @brief This file is used to benchmark the UserDefined::String class.
+ *
+ * Every heap allocation made by the process is counted through a replaced global operator new,
+ * so each benchmark reports the number of allocations per operation next to its timing.
+ **************************************************************************************************/
+
+#include "String.hpp"
+#include "BatchWriter.hpp"
+#include "InternPool.hpp"
+#include "Join.hpp"
+#include "LineReader.hpp"
+#include "MappedString.hpp"
+#include "MultiMatcher.hpp"
+#include "Searcher.hpp"
+#include "Split.hpp"
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <strings.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    std::size_t allocationCount = 0;    ///< Number of calls to the global operator new.
+
+    /**
+     * @brief Prevents the compiler from optimizing away a benchmarked value.
+     *
+     * @param value The value to keep alive.
+     */
+    template <typename T>
+    void doNotOptimize(const T& value)
+    {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    /**
+     * @brief Runs an operation repeatedly and prints its cost.
+     *
+     * @param benchmarkName The name printed in the report.
+     * @param iterations The number of times to run the operation.
+     * @param operation The operation to measure.
+     */
+    template <typename Operation>
+    void runBenchmark(const char* benchmarkName, std::size_t iterations, Operation operation)
+    {
+        std::size_t allocationsBefore = allocationCount;
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            operation();
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        double allocationsPerOp = static_cast<double>(allocationCount - allocationsBefore) / iterations;
+
+        std::printf("%-36s %10.2f ns/op %8.2f allocs/op\n", benchmarkName, static_cast<double>(elapsed) / iterations, allocationsPerOp);
+    }
+
+    /**
+     * @brief Runs a scan over a buffer repeatedly and prints its throughput.
+     *
+     * @param benchmarkName The name printed in the report.
+     * @param bufferSize The number of bytes scanned per call.
+     * @param operation The scan to measure; returns a value that is kept alive.
+     */
+    template <typename Operation>
+    void runThroughputBenchmark(const char* benchmarkName, std::size_t bufferSize, Operation operation)
+    {
+        std::size_t repetitions = std::max<std::size_t>(1, (std::size_t(256) << 20) / bufferSize);
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < repetitions; ++i)
+        {
+            doNotOptimize(operation());
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        std::printf("  %-34s %10.2f GB/s\n", benchmarkName, static_cast<double>(bufferSize) * repetitions / elapsed);
+    }
+
+    /**
+     * @brief Interns the same identifiers from several threads at once and prints the lookup throughput.
+     *
+     * Every thread starts at a different offset, so the first pass races to insert the identifiers
+     * and later passes are lookups of identifiers that are already interned.
+     *
+     * @param identifiers The identifiers to intern.
+     * @param threadCount The number of interning threads.
+     * @param lookupsPerThread The number of intern() calls made by each thread.
+     */
+    void runInternBenchmark(const std::vector<UserDefined::String>& identifiers, std::size_t threadCount, std::size_t lookupsPerThread)
+    {
+        UserDefined::InternPool pool;
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&identifiers, &pool, t, lookupsPerThread]() {
+                std::size_t index = t * 997;
+                for (std::size_t i = 0; i < lookupsPerThread; ++i)
+                {
+                    doNotOptimize(pool.intern(identifiers[index % identifiers.size()]));
+                    index++;
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        double lookups = static_cast<double>(threadCount * lookupsPerThread);
+
+        std::printf("InternPool, %zu thread(s)%-13s %10.2f Mlookups/s (%zu distinct)\n", threadCount, "", lookups * 1000.0 / elapsed, pool.size());
+    }
+}
+
+// The replacement functions are kept out of line: inlined into library code, GCC 12 matches the
+// malloc() and free() inside them against each other and issues spurious -Wmismatched-new-delete.
+__attribute__((noinline)) void* operator new(std::size_t size)
+{
+    ++allocationCount;
+    if (void* memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+__attribute__((noinline)) void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main()
+{
+    using namespace UserDefined::Literals;
+
+    const std::size_t iterations = 1000000;
+    const char* shortText = "short-token-0123456789";     // 22 characters, stored inline.
+    const char* longText = "a-key-that-is-too-long-for-the-inline-buffer";
+    const std::vector<char> shortVector(shortText, shortText + std::strlen(shortText));
+    const UserDefined::String shortString(shortText);
+    const UserDefined::String longString(longText);
+    const UserDefined::String shortHalf("0123456789");
+    static constexpr auto shortFixed = UserDefined::makeFixedString("short-token-0123456789");
+
+    std::printf("--- Short strings (%zu characters) ---\n", std::strlen(shortText));
+
+    runBenchmark("Default constructor", iterations, [&]() {
+        UserDefined::String s;
+        doNotOptimize(s);
+    });
+
+    runBenchmark("C-string constructor", iterations, [&]() {
+        UserDefined::String s(shortText);
+        doNotOptimize(s);
+    });
+
+    runBenchmark("_sv literal constructor", iterations, [&]() {
+        UserDefined::String s("short-token-0123456789"_sv);
+        doNotOptimize(s);
+    });
+
+    runBenchmark("FixedString constructor", iterations, [&]() {
+        UserDefined::String s(shortFixed);
+        doNotOptimize(s);
+    });
+
+    runBenchmark("Vector constructor", iterations, [&]() {
+        UserDefined::String s(shortVector);
+        doNotOptimize(s);
+    });
+
+    runBenchmark("Copy constructor", iterations, [&]() {
+        UserDefined::String s(shortString);
+        doNotOptimize(s);
+    });
+
+    runBenchmark("Move constructor", iterations, [&]() {
+        UserDefined::String source(shortString);
+        UserDefined::String s(std::move(source));
+        doNotOptimize(s);
+    });
+
+    runBenchmark("Copy assignment", iterations, [&]() {
+        UserDefined::String s;
+        s = shortString;
+        doNotOptimize(s);
+    });
+
+    runBenchmark("Move assignment", iterations, [&]() {
+        UserDefined::String source(shortString);
+        UserDefined::String s;
+        s = std::move(source);
+        doNotOptimize(s);
+    });
+
+    runBenchmark("Operator+", iterations, [&]() {
+        UserDefined::String s = shortHalf + shortHalf;
+        doNotOptimize(s);
+    });
+
+    std::istringstream shortLines;
+    UserDefined::String extracted;
+    std::string shortInput;
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        shortInput.append(shortText).push_back('\n');
+    }
+    shortLines.str(shortInput);
+
+    runBenchmark("Operator>>", iterations, [&]() {
+        shortLines >> extracted;
+        doNotOptimize(extracted);
+    });
+
+    std::printf("--- Long strings (%zu characters) ---\n", std::strlen(longText));
+
+    runBenchmark("C-string constructor", iterations, [&]() {
+        UserDefined::String s(longText);
+        doNotOptimize(s);
+    });
+
+    runBenchmark("Copy constructor", iterations, [&]() {
+        UserDefined::String s(longString);
+        doNotOptimize(s);
+    });
+
+    runBenchmark("Operator+", iterations, [&]() {
+        UserDefined::String s = longString + shortHalf;
+        doNotOptimize(s);
+    });
+
+    std::printf("--- Building a 1 MB string ---\n");
+
+    runBenchmark("push_back (1 MB)", 10, [&]() {
+        UserDefined::String s;
+        for (std::size_t i = 0; i < (1 << 20); ++i)
+        {
+            s.push_back('x');
+        }
+        doNotOptimize(s);
+    });
+
+    runBenchmark("append 16-char pieces (1 MB)", 10, [&]() {
+        UserDefined::String s;
+        for (std::size_t i = 0; i < (1 << 16); ++i)
+        {
+            s.append("0123456789abcdef", 16);
+        }
+        doNotOptimize(s);
+    });
+
+    runBenchmark("operator+ 16-char pieces (64 KB)", 10, [&]() {
+        UserDefined::String s;
+        UserDefined::String piece("0123456789abcdef");
+        for (std::size_t i = 0; i < (1 << 12); ++i)
+        {
+            s = s + piece;
+        }
+        doNotOptimize(s);
+    });
+
+    std::printf("--- 16-way concatenation ---\n");
+
+    const UserDefined::String p[16] = {
+        "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel",
+        "india", "juliett", "kilo", "lima", "mike", "november", "oscar", "papa"
+    };
+
+    runBenchmark("Eager (temporary per +)", iterations / 10, [&]() {
+        UserDefined::String s = p[0];
+        for (std::size_t i = 1; i < 16; ++i)
+        {
+            s = UserDefined::String(s + p[i]);
+        }
+        doNotOptimize(s);
+    });
+
+    runBenchmark("Lazy (expression template)", iterations / 10, [&]() {
+        UserDefined::String s = p[0] + p[1] + p[2] + p[3] + p[4] + p[5] + p[6] + p[7]
+                              + p[8] + p[9] + p[10] + p[11] + p[12] + p[13] + p[14] + p[15];
+        doNotOptimize(s);
+    });
+
+    std::printf("--- Per-request strings (64 long strings per request) ---\n");
+
+    runBenchmark("Default resource", iterations / 100, [&]() {
+        std::vector<UserDefined::String> request;
+        request.reserve(64);
+        for (std::size_t i = 0; i < 64; ++i)
+        {
+            request.emplace_back(longText);
+        }
+        doNotOptimize(request);
+    });
+
+    UserDefined::MonotonicArena requestArena(16 * 1024);
+    runBenchmark("Monotonic arena", iterations / 100, [&]() {
+        std::vector<UserDefined::String> request;
+        request.reserve(64);
+        for (std::size_t i = 0; i < 64; ++i)
+        {
+            request.emplace_back(longText, &requestArena);
+        }
+        doNotOptimize(request);
+        request.clear();
+        requestArena.release();
+    });
+
+    std::printf("--- Parsing a request line into method, path and version ---\n");
+
+    const UserDefined::String requestLine("GET /api/v1/resources/12345/details HTTP/1.1");
+
+    runBenchmark("Copying fields into Strings", iterations, [&]() {
+        std::size_t pathStart = requestLine.find(' ') + 1;
+        std::size_t pathEnd = requestLine.find(' ', pathStart);
+        UserDefined::String method(UserDefined::StringView(requestLine.c_str(), pathStart - 1));
+        UserDefined::String path(UserDefined::StringView(requestLine.c_str() + pathStart, pathEnd - pathStart));
+        UserDefined::String version(UserDefined::StringView(requestLine.c_str() + pathEnd + 1, requestLine.length() - pathEnd - 1));
+        doNotOptimize(method);
+        doNotOptimize(path);
+        doNotOptimize(version);
+    });
+
+    runBenchmark("Slicing fields as StringViews", iterations, [&]() {
+        UserDefined::StringView line = requestLine;
+        std::size_t pathStart = line.find(' ') + 1;
+        std::size_t pathEnd = line.find(' ', pathStart);
+        UserDefined::StringView method = line.substr(0, pathStart - 1);
+        UserDefined::StringView path = line.substr(pathStart, pathEnd - pathStart);
+        UserDefined::StringView version = line.substr(pathEnd + 1);
+        doNotOptimize(method);
+        doNotOptimize(path);
+        doNotOptimize(version);
+    });
+
+    std::printf("--- Reading lines (32 MB of log lines) ---\n");
+
+    std::string logText;
+    for (std::size_t i = 0; logText.size() < (std::size_t(32) << 20); ++i)
+    {
+        logText += "2024-01-01T00:00:00Z INFO request " + std::to_string(i) + " served in " + std::to_string(i % 997) + " us\n";
+    }
+    std::istringstream logInput(logText);
+    auto rewindLog = [&logInput]() -> std::istream& {
+        logInput.clear();
+        logInput.seekg(0);
+        return logInput;
+    };
+
+    runThroughputBenchmark("std::getline(std::string)", logText.size(), [&]() {
+        std::istream& input = rewindLog();
+        std::string line;
+        std::size_t lineCount = 0;
+        while (std::getline(input, line))
+        {
+            lineCount++;
+        }
+        return lineCount;
+    });
+    runThroughputBenchmark("operator>>(String)", logText.size(), [&]() {
+        std::istream& input = rewindLog();
+        UserDefined::String line;
+        std::size_t lineCount = 0;
+        while (input >> line)
+        {
+            lineCount++;
+        }
+        return lineCount;
+    });
+    runThroughputBenchmark("LineReader (String)", logText.size(), [&]() {
+        std::istream& input = rewindLog();
+        UserDefined::LineReader reader(input);
+        UserDefined::String line;
+        std::size_t lineCount = 0;
+        while (reader.readLine(line))
+        {
+            lineCount++;
+        }
+        return lineCount;
+    });
+    runThroughputBenchmark("LineReader (StringView)", logText.size(), [&]() {
+        std::istream& input = rewindLog();
+        UserDefined::LineReader reader(input);
+        UserDefined::StringView line;
+        std::size_t lineCount = 0;
+        while (reader.readLine(line))
+        {
+            lineCount++;
+        }
+        return lineCount;
+    });
+
+    std::printf("--- Loading a 32 MB file (from the page cache) ---\n");
+
+    const char* logPath = "/tmp/BenchStringLog.txt";
+    {
+        std::ofstream logFile(logPath, std::ios::binary);
+        logFile.write(logText.data(), static_cast<std::streamsize>(logText.size()));
+    }
+    runThroughputBenchmark("ifstream + operator>>(String)", logText.size(), [&]() {
+        std::ifstream input(logPath, std::ios::binary);
+        UserDefined::String line;
+        std::size_t lineCount = 0;
+        while (input >> line)
+        {
+            lineCount++;
+        }
+        return lineCount;
+    });
+    runThroughputBenchmark("MappedString::open", logText.size(), [&]() {
+        return UserDefined::MappedString::open(logPath).length();
+    });
+    runThroughputBenchmark("MappedString::open + count lines", logText.size(), [&]() {
+        return UserDefined::MappedString::open(logPath).count('\n');
+    });
+    runThroughputBenchmark("MappedString::open + split lines", logText.size(), [&]() {
+        UserDefined::MappedString mapped = UserDefined::MappedString::open(logPath);
+        std::size_t lineCount = 0;
+        for (UserDefined::StringView line : UserDefined::split(mapped, '\n'))
+        {
+            lineCount += !line.empty();
+        }
+        return lineCount;
+    });
+    std::remove(logPath);
+
+    std::printf("--- Writing 100000 log lines to /dev/null ---\n");
+
+    std::vector<UserDefined::String> outputLines;
+    std::size_t outputBytes = 0;
+    for (std::size_t i = 0; i < 100000; ++i)
+    {
+        outputLines.push_back(UserDefined::String("2024-01-01T00:00:00Z INFO request ") + std::to_string(i) + " served\n");
+        outputBytes += outputLines.back().length();
+    }
+    int nullDescriptor = ::open("/dev/null", O_WRONLY);
+    std::ofstream nullStream("/dev/null");
+
+    runThroughputBenchmark("write() per line", outputBytes, [&]() {
+        std::size_t written = 0;
+        for (const UserDefined::String& line : outputLines)
+        {
+            written += static_cast<std::size_t>(::write(nullDescriptor, line.c_str(), line.length()));
+        }
+        return written;
+    });
+    runThroughputBenchmark("std::ofstream << String", outputBytes, [&]() {
+        for (const UserDefined::String& line : outputLines)
+        {
+            nullStream << line;
+        }
+        nullStream.flush();
+        return nullStream.good();
+    });
+    runThroughputBenchmark("BatchWriter (writev)", outputBytes, [&]() {
+        UserDefined::BatchWriter writer(nullDescriptor);
+        for (const UserDefined::String& line : outputLines)
+        {
+            writer << line;
+        }
+        return writer.flush();
+    });
+    ::close(nullDescriptor);
+
+    std::printf("--- Tokenizing (32 MB of comma-separated fields) ---\n");
+
+    std::string csvText;
+    for (std::size_t i = 0; csvText.size() < (std::size_t(32) << 20); ++i)
+    {
+        csvText += std::to_string(i) + ",user" + std::to_string(i % 1000) + ",GET,/api/v1/items," + std::to_string(i % 500) + ",200\n";
+    }
+
+    runThroughputBenchmark("std::string::find + substr", csvText.size(), [&]() {
+        std::size_t tokenCount = 0;
+        for (std::size_t start = 0, end; start <= csvText.size(); start = end + 1)
+        {
+            end = csvText.find_first_of(",\n", start);
+            end = end == std::string::npos ? csvText.size() : end;
+            std::string token = csvText.substr(start, end - start);
+            tokenCount += !token.empty();
+        }
+        return tokenCount;
+    });
+    runThroughputBenchmark("splitAny (views)", csvText.size(), [&]() {
+        std::size_t tokenCount = 0;
+        for (UserDefined::StringView token : UserDefined::splitAny(csvText, ",\n"))
+        {
+            tokenCount += !token.empty();
+        }
+        return tokenCount;
+    });
+    runThroughputBenchmark("split lines, then fields (views)", csvText.size(), [&]() {
+        std::size_t tokenCount = 0;
+        for (UserDefined::StringView line : UserDefined::split(csvText, '\n'))
+        {
+            for (UserDefined::StringView token : UserDefined::split(line, ','))
+            {
+                tokenCount += !token.empty();
+            }
+        }
+        return tokenCount;
+    });
+    for (std::size_t threadCount : { 1, 2, 4 })
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "splitAny toVector, %zu thread(s)", threadCount);
+        runThroughputBenchmark(name, csvText.size(), [&]() { return UserDefined::splitAny(csvText, ",\n").toVector(threadCount).size(); });
+    }
+
+    std::printf("--- Keyword scan (200 keywords over 1 MB) ---\n");
+
+    std::vector<std::string> keywordStorage;
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+        keywordStorage.push_back("kw" + std::to_string(i * 7919 % 100000) + "_");
+    }
+    std::string keywordText;
+    for (std::size_t i = 0; keywordText.size() < (std::size_t(1) << 20); ++i)
+    {
+        keywordText += i % 50 == 0 ? keywordStorage[i % keywordStorage.size()] : "lorem ipsum dolor sit amet ";
+    }
+    UserDefined::String keywordHaystack{ UserDefined::StringView(keywordText) };
+    std::vector<UserDefined::StringView> keywordViews(keywordStorage.begin(), keywordStorage.end());
+    UserDefined::MultiMatcher keywordMatcher(keywordViews);
+
+    runThroughputBenchmark("String::find, once per keyword", keywordText.size(), [&]() {
+        std::size_t matchCount = 0;
+        for (UserDefined::StringView keyword : keywordViews)
+        {
+            for (std::size_t position = keywordHaystack.find(keyword); position != UserDefined::String::npos; position = keywordHaystack.find(keyword, position + 1))
+            {
+                matchCount++;
+            }
+        }
+        return matchCount;
+    });
+    runThroughputBenchmark("MultiMatcher, one pass", keywordText.size(), [&]() {
+        std::size_t matchCount = 0;
+        keywordMatcher.scan(keywordHaystack, [&matchCount](const UserDefined::MultiMatcher::Match&) { matchCount++; });
+        return matchCount;
+    });
+
+    std::printf("--- Search (match only at the end of the buffer) ---\n");
+
+    for (std::size_t bufferSize : { std::size_t(1) << 10, std::size_t(64) << 10, std::size_t(1) << 20, std::size_t(64) << 20 })
+    {
+        std::string stdHaystack(bufferSize - 6, 'a');
+        stdHaystack.append("needle");
+        UserDefined::String haystack(stdHaystack.c_str());
+
+        std::printf(" %zu KB\n", bufferSize >> 10);
+        runThroughputBenchmark("memchr", bufferSize, [&]() { return std::memchr(stdHaystack.data(), 'n', stdHaystack.size()); });
+        runThroughputBenchmark("std::string::find(char)", bufferSize, [&]() { return stdHaystack.find('n'); });
+        runThroughputBenchmark("std::string::find(substring)", bufferSize, [&]() { return stdHaystack.find("needle"); });
+        runThroughputBenchmark("std::string::find_first_of", bufferSize, [&]() { return stdHaystack.find_first_of("xyzn"); });
+
+        for (auto level : { UserDefined::Simd::Level::Scalar, UserDefined::Simd::Level::SSE2, UserDefined::Simd::Level::AVX2 })
+        {
+            if (UserDefined::Simd::setLevel(level) != level)
+            {
+                continue;
+            }
+            const char* levelName = level == UserDefined::Simd::Level::AVX2 ? "AVX2" : level == UserDefined::Simd::Level::SSE2 ? "SSE2" : "Scalar";
+            char name[64];
+
+            std::snprintf(name, sizeof(name), "String::find(char) [%s]", levelName);
+            runThroughputBenchmark(name, bufferSize, [&]() { return haystack.find('n'); });
+            std::snprintf(name, sizeof(name), "String::find(substring) [%s]", levelName);
+            runThroughputBenchmark(name, bufferSize, [&]() { return haystack.find("needle"); });
+            std::snprintf(name, sizeof(name), "String::rfind(char) [%s]", levelName);
+            runThroughputBenchmark(name, bufferSize, [&]() { return haystack.rfind('b'); });
+            std::snprintf(name, sizeof(name), "String::find_first_of [%s]", levelName);
+            runThroughputBenchmark(name, bufferSize, [&]() { return haystack.find_first_of("xyzn"); });
+            std::snprintf(name, sizeof(name), "String::count [%s]", levelName);
+            runThroughputBenchmark(name, bufferSize, [&]() { return haystack.count('n'); });
+        }
+        UserDefined::Simd::setLevel(UserDefined::Simd::supportedLevel());
+    }
+
+    std::printf("--- Precompiled needles (random 4 MB haystack and needle) ---\n");
+
+    std::mt19937 searchRandom(15);
+    for (std::size_t alphabet : { std::size_t(2), std::size_t(4), std::size_t(26), std::size_t(64), std::size_t(256) })
+    {
+        std::string searchText(std::size_t(4) << 20, ' ');
+        for (char& ch : searchText)
+        {
+            ch = static_cast<char>(alphabet == 256 ? searchRandom() % 256 : 'a' + searchRandom() % alphabet);
+        }
+
+        for (std::size_t needleLength : { std::size_t(8), std::size_t(32), std::size_t(128), std::size_t(512), std::size_t(2048), std::size_t(8192) })
+        {
+            std::string needle(needleLength, ' ');
+            for (char& ch : needle)
+            {
+                ch = static_cast<char>(alphabet == 256 ? searchRandom() % 256 : 'a' + searchRandom() % alphabet);
+            }
+            searchText.replace(searchText.size() - needleLength, needleLength, needle);
+            std::size_t expectedPosition = searchText.find(needle);
+            std::size_t scannedLength = expectedPosition + needleLength;
+            UserDefined::String searchHaystack{ UserDefined::StringView(searchText) };
+
+            // Short needles over small alphabets occur by chance, so throughput is over the characters actually scanned.
+            std::printf(" alphabet %zu, needle %zu (%zu KB scanned)\n", alphabet, needleLength, scannedLength >> 10);
+            runThroughputBenchmark("std::string::find", scannedLength, [&]() { return searchText.find(needle); });
+            for (auto strategy : { UserDefined::Searcher::Strategy::Filter, UserDefined::Searcher::Strategy::Horspool, UserDefined::Searcher::Strategy::TwoWay })
+            {
+                UserDefined::Searcher searcher(needle, strategy);
+                const char* strategyName = strategy == UserDefined::Searcher::Strategy::Filter ? "Filter" : strategy == UserDefined::Searcher::Strategy::Horspool ? "Horspool" : "TwoWay";
+                char name[64];
+                std::snprintf(name, sizeof(name), "Searcher [%s]%s", strategyName, UserDefined::Searcher(needle).strategy() == strategy ? " (auto)" : "");
+                if (searcher.find(searchHaystack) != expectedPosition)
+                {
+                    std::printf("  %s: wrong result\n", name);
+                }
+                runThroughputBenchmark(name, scannedLength, [&]() { return searcher.find(searchHaystack); });
+            }
+        }
+    }
+
+    std::printf("--- Hashing ---\n");
+
+    for (std::size_t bufferSize : { std::size_t(16), std::size_t(64), std::size_t(1) << 10, std::size_t(1) << 20 })
+    {
+        std::string stdInput(bufferSize, 'h');
+        UserDefined::String input(stdInput.c_str());
+
+        std::printf(" %zu bytes\n", bufferSize);
+        runThroughputBenchmark("std::hash<std::string>", bufferSize, [&]() { return std::hash<std::string>()(stdInput); });
+        runThroughputBenchmark("hashBytes", bufferSize, [&]() { return UserDefined::hashBytes(input.c_str(), input.length()); });
+        runThroughputBenchmark("String::hash (cached)", bufferSize, [&]() { return input.hash(); });
+    }
+
+    std::vector<std::string> stdKeys;
+    std::vector<UserDefined::String> keys;
+    std::unordered_map<std::string, std::size_t> stdMap;
+    std::unordered_map<UserDefined::String, std::size_t> map;
+    for (std::size_t i = 0; i < 4096; ++i)
+    {
+        stdKeys.push_back("/api/v1/resources/" + std::to_string(i) + "/details");
+        keys.emplace_back(stdKeys.back().c_str());
+        stdMap.emplace(stdKeys.back(), i);
+        map.emplace(keys.back(), i);
+    }
+
+    std::size_t lookupIndex = 0;
+    runBenchmark("unordered_map<std::string>::find", iterations, [&]() {
+        doNotOptimize(stdMap.find(stdKeys[lookupIndex++ % stdKeys.size()]));
+    });
+    lookupIndex = 0;
+    runBenchmark("unordered_map<String>::find", iterations, [&]() {
+        doNotOptimize(map.find(keys[lookupIndex++ % keys.size()]));
+    });
+
+    std::printf("--- Joining 10000 strings ---\n");
+
+    std::vector<UserDefined::String> joinPieces;
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+        joinPieces.push_back(UserDefined::String("column_value_") + std::to_string(i));
+    }
+    runBenchmark("operator+ per piece", 10, [&]() {
+        UserDefined::String joined;
+        for (std::size_t i = 0; i < joinPieces.size(); ++i)
+        {
+            joined = i == 0 ? UserDefined::String(joinPieces[i]) : UserDefined::String(joined + ", " + joinPieces[i]);
+        }
+        doNotOptimize(joined);
+    });
+    runBenchmark("operator+= per piece", 1000, [&]() {
+        UserDefined::String joined;
+        for (std::size_t i = 0; i < joinPieces.size(); ++i)
+        {
+            if (i != 0)
+            {
+                joined += ", ";
+            }
+            joined += joinPieces[i];
+        }
+        doNotOptimize(joined);
+    });
+    runBenchmark("join", 1000, [&]() {
+        UserDefined::String joined = UserDefined::join(joinPieces, ", ");
+        doNotOptimize(joined);
+    });
+
+    std::printf("--- Joining 256 MB ---\n");
+
+    {
+        std::vector<UserDefined::String> reportPieces;
+        std::string reportLine(4095, 'r');
+        for (std::size_t i = 0; i < 65536; ++i)
+        {
+            reportPieces.emplace_back(UserDefined::StringView(reportLine));
+        }
+        for (std::size_t threadCount : { 1, 2, 4 })
+        {
+            auto start = std::chrono::steady_clock::now();
+            UserDefined::String report = UserDefined::join(reportPieces, "\n", threadCount);
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            char name[64];
+            std::snprintf(name, sizeof(name), "join, %zu thread(s)", threadCount);
+            std::printf("  %-34s %10.2f GB/s\n", name, static_cast<double>(report.length()) / elapsed);
+        }
+    }
+
+    std::printf("--- Replacing placeholders in a 100 MB template ---\n");
+
+    {
+        std::string templateLine = "Dear {name}, your order {order} ships on {date}; reply to {name} with questions.\n";
+        std::string stdTemplate;
+        while (stdTemplate.size() < (std::size_t(100) << 20))
+        {
+            stdTemplate += templateLine;
+        }
+        UserDefined::String templateText{ UserDefined::StringView(stdTemplate) };
+
+        auto reportReplace = [&](const char* name, std::size_t bytes, std::chrono::steady_clock::time_point start) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            std::printf("  %-34s %10.1f MB/s\n", name, 1000.0 * static_cast<double>(bytes) / elapsed);
+        };
+
+        // The std::string loop shifts the rest of the text at every replacement: quadratic, so only 1 MB.
+        std::string stdSmall = stdTemplate.substr(0, std::size_t(1) << 20);
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t found = stdSmall.find("{name}"); found != std::string::npos; found = stdSmall.find("{name}", found + 12))
+        {
+            stdSmall.replace(found, 6, "Ada Lovelace");
+        }
+        reportReplace("std::string find+replace (1 MB)", std::size_t(1) << 20, start);
+
+        start = std::chrono::steady_clock::now();
+        UserDefined::String rebuilt;
+        std::size_t read = 0;
+        for (std::size_t found = templateText.find("{name}"); found != UserDefined::String::npos; found = templateText.find("{name}", read))
+        {
+            rebuilt.append(templateText.c_str() + read, found - read);
+            rebuilt.append("Ada Lovelace");
+            read = found + 6;
+        }
+        rebuilt.append(templateText.c_str() + read, templateText.length() - read);
+        reportReplace("find+append into a new String", templateText.length(), start);
+
+        UserDefined::String growing(templateText);
+        start = std::chrono::steady_clock::now();
+        growing.replace_all("{name}", "Ada Lovelace");
+        reportReplace("replace_all (longer)", templateText.length(), start);
+        if (!(growing == rebuilt))
+        {
+            std::printf("  replace_all (longer): wrong result\n");
+        }
+
+        UserDefined::String shrinking(templateText);
+        start = std::chrono::steady_clock::now();
+        shrinking.replace_all("{order}", "42");
+        reportReplace("replace_all (shorter, in place)", templateText.length(), start);
+    }
+
+    std::printf("--- Sorting 10M strings ---\n");
+
+    // Paths with a shared prefix and random ids: comparisons scan the prefix before finding a difference.
+    {
+        const std::size_t sortCount = 10000000;
+        std::mt19937_64 sortRandom(20);
+        std::vector<std::string> stdSorted;
+        stdSorted.reserve(sortCount);
+        for (std::size_t i = 0; i < sortCount; ++i)
+        {
+            stdSorted.push_back("/srv/data/shard-" + std::to_string(sortRandom() % 64) + "/object-" + std::to_string(sortRandom() % 1000000000));
+        }
+
+        {
+            std::vector<UserDefined::String> sorted(stdSorted.begin(), stdSorted.end());
+            std::size_t allocationsBefore = allocationCount;
+            auto start = std::chrono::steady_clock::now();
+            std::sort(sorted.begin(), sorted.end());
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            std::printf("%-36s %10lld ms %8zu allocs\n", "std::sort(vector<String>)", static_cast<long long>(elapsed), allocationCount - allocationsBefore);
+        }
+
+        std::size_t allocationsBefore = allocationCount;
+        auto start = std::chrono::steady_clock::now();
+        std::sort(stdSorted.begin(), stdSorted.end());
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-36s %10lld ms %8zu allocs\n", "std::sort(vector<std::string>)", static_cast<long long>(elapsed), allocationCount - allocationsBefore);
+    }
+
+    std::printf("--- Converting numbers ---\n");
+
+    {
+        std::mt19937_64 numberRandom(24);
+        std::vector<long long> integers;
+        std::vector<double> doubles;
+        std::vector<std::string> integerTexts, doubleTexts, priceTexts;
+        for (std::size_t i = 0; i < 4096; ++i)
+        {
+            long long integer = static_cast<long long>(numberRandom() >> (numberRandom() % 64));
+            integers.push_back(i % 2 == 0 ? integer : -integer);
+            doubles.push_back(std::ldexp(static_cast<double>(numberRandom() >> 11), static_cast<int>(numberRandom() % 200) - 150));
+            char text[64];
+            integerTexts.push_back(std::to_string(integers.back()));
+            std::snprintf(text, sizeof(text), "%.17g", doubles.back());
+            doubleTexts.push_back(text);
+            std::snprintf(text, sizeof(text), "%.2f", static_cast<double>(numberRandom() % 1000000) / 100);
+            priceTexts.push_back(text);
+        }
+
+        std::size_t index = 0;
+        char buffer[64];
+        long long integerSink = 0;
+        double doubleSink = 0;
+        runBenchmark("snprintf(\"%lld\")", iterations, [&]() {
+            doNotOptimize(std::snprintf(buffer, sizeof(buffer), "%lld", integers[index++ % 4096]));
+        });
+        runBenchmark("std::to_string(long long)", iterations, [&]() {
+            std::string text = std::to_string(integers[index++ % 4096]);
+            doNotOptimize(text);
+        });
+        runBenchmark("String::fromInt", iterations, [&]() {
+            UserDefined::String text = UserDefined::String::fromInt(integers[index++ % 4096]);
+            doNotOptimize(text);
+        });
+        runBenchmark("snprintf(\"%.17g\")", iterations, [&]() {
+            doNotOptimize(std::snprintf(buffer, sizeof(buffer), "%.17g", doubles[index++ % 4096]));
+        });
+        runBenchmark("String::fromDouble (shortest)", iterations, [&]() {
+            UserDefined::String text = UserDefined::String::fromDouble(doubles[index++ % 4096]);
+            doNotOptimize(text);
+        });
+        runBenchmark("strtoll", iterations, [&]() {
+            integerSink += std::strtoll(integerTexts[index++ % 4096].c_str(), nullptr, 10);
+        });
+        runBenchmark("parseInt", iterations, [&]() {
+            long long value = 0;
+            UserDefined::parseInt(integerTexts[index++ % 4096], value);
+            integerSink += value;
+        });
+        runBenchmark("strtod (17 digits)", iterations, [&]() {
+            doubleSink += std::strtod(doubleTexts[index++ % 4096].c_str(), nullptr);
+        });
+        runBenchmark("parseDouble (17 digits)", iterations, [&]() {
+            double value = 0;
+            UserDefined::parseDouble(doubleTexts[index++ % 4096], value);
+            doubleSink += value;
+        });
+        runBenchmark("strtod (prices)", iterations, [&]() {
+            doubleSink += std::strtod(priceTexts[index++ % 4096].c_str(), nullptr);
+        });
+        runBenchmark("parseDouble (prices)", iterations, [&]() {
+            double value = 0;
+            UserDefined::parseDouble(priceTexts[index++ % 4096], value);
+            doubleSink += value;
+        });
+        doNotOptimize(integerSink);
+        doNotOptimize(doubleSink);
+    }
+
+    std::printf("--- Case-insensitive keys ---\n");
+
+    {
+        std::string stdMixed;
+        while (stdMixed.size() < (std::size_t(1) << 20))
+        {
+            stdMixed += "Content-Type: Text/HTML; Charset=UTF-8\r\nAccept-Encoding: GZIP, Deflate\r\n";
+        }
+        UserDefined::String mixed{ UserDefined::StringView(stdMixed) };
+        runThroughputBenchmark("std::transform(::tolower)", stdMixed.size(), [&]() {
+            std::transform(stdMixed.begin(), stdMixed.end(), stdMixed.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+            return stdMixed.data();
+        });
+        runThroughputBenchmark("String::toLower (in place)", mixed.length(), [&]() {
+            return mixed.toLower().c_str();
+        });
+
+        const char* names[] = { "Content-Type", "content-length", "ACCEPT-ENCODING", "X-Request-Id", "Cache-Control", "user-agent",
+                                "If-None-Match", "Authorization", "Transfer-Encoding", "x-forwarded-for" };
+        std::vector<UserDefined::String> lookups;
+        std::unordered_map<std::string, int> lowercasedHeaders;
+        std::unordered_map<UserDefined::String, int, UserDefined::CaseInsensitiveHash, UserDefined::CaseInsensitiveEqual> headers;
+        for (const char* name : names)
+        {
+            UserDefined::String upper = UserDefined::toUpper(name);
+            lookups.push_back(upper);
+            lowercasedHeaders[UserDefined::toLower(name).c_str()] = 1;
+            headers[name] = 1;
+        }
+
+        std::size_t index = 0;
+        std::size_t found = 0;
+        runBenchmark("strncasecmp (header names)", iterations, [&]() {
+            const UserDefined::String& key = lookups[index++ % 10];
+            found += key.length() == std::strlen(names[index % 10]) && strncasecmp(key.c_str(), names[index % 10], key.length()) == 0;
+        });
+        runBenchmark("equalsIgnoreCase (header names)", iterations, [&]() {
+            const UserDefined::String& key = lookups[index++ % 10];
+            found += key.equalsIgnoreCase(names[index % 10]);
+        });
+        runBenchmark("lowercase copy + unordered_map", iterations, [&]() {
+            std::string key = lookups[index++ % 10].c_str();
+            std::transform(key.begin(), key.end(), key.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+            found += lowercasedHeaders.count(key);
+        });
+        runBenchmark("CaseInsensitiveHash unordered_map", iterations, [&]() {
+            found += headers.count(lookups[index++ % 10]);
+        });
+        doNotOptimize(found);
+    }
+
+    std::printf("--- Concurrent interning of 4096 identifiers ---\n");
+
+    std::vector<UserDefined::String> identifiers;
+    for (std::size_t i = 0; i < 4096; ++i)
+    {
+        identifiers.push_back(UserDefined::String("identifier_") + std::to_string(i));
+    }
+    for (std::size_t threadCount : { 1, 2, 4, 8 })
+    {
+        runInternBenchmark(identifiers, threadCount, iterations);
+    }
+
+    return 0;
+}
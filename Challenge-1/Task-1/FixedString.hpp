@@ -0,0 +1,301 @@
+/**************************************************************************************************
+ * @file FixedString.hpp
+ *
+ * @brief A constexpr string with its characters stored inline.
+ *
+ * This file contains the definition of FixedString, a string of at most N
+ * characters kept in an array inside the object. Every member is constexpr, so
+ * fixed strings can be built, appended to and compared at compile time, and a
+ * FixedString constant lives in static storage with its length already known:
+ * using it as a StringView or copying it into a String involves no strlen() and
+ * no allocation at run time.
+ *
+ **************************************************************************************************/
+
+#ifndef FIXED_STRING_HPP
+#define FIXED_STRING_HPP
+
+#include "StringView.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+namespace UserDefined
+{
+    /**
+     * @class FixedString
+     * @brief A string of up to Capacity characters, null-terminated, with no heap storage.
+     *
+     * Fixed strings convert implicitly to StringView, so they can be passed to anything
+     * that takes a view (searching, splitting, String::append() and operator+, ...), and
+     * explicitly to String.
+     *
+     * @tparam Capacity The largest number of characters the string can hold.
+     */
+    template <std::size_t Capacity>
+    class FixedString
+    {
+    public:
+
+        // #region Constructors
+
+        /**
+         * @brief Default constructor.
+         *
+         * Constructs an empty string.
+         */
+        constexpr FixedString() noexcept
+            : _strData{}
+            , _strLength(0)
+        {
+        }
+
+        /**
+         * @brief Constructs a string from a string literal, whose length is known at compile time.
+         *
+         * @param literal The literal; it must fit in the capacity.
+         */
+        template <std::size_t LiteralSize>
+        constexpr FixedString(const char (&literal)[LiteralSize]) noexcept
+            : _strData{}
+            , _strLength(LiteralSize - 1)
+        {
+            static_assert(LiteralSize - 1 <= Capacity, "The literal does not fit in the FixedString.");
+            for (std::size_t i = 0; i < _strLength; ++i)
+            {
+                _strData[i] = literal[i];
+            }
+        }
+
+        /**
+         * @brief Constructs a string from a copy of the characters of a view.
+         *
+         * @param inputView The characters to copy; there must be at most Capacity of them.
+         */
+        constexpr explicit FixedString(StringView inputView) noexcept
+            : _strData{}
+            , _strLength(0)
+        {
+            append(inputView);
+        }
+
+        // #endregion
+
+        // #region Overloaded Operators
+
+        /**
+         * @brief Gets a character of the string.
+         *
+         * @param index The position of the character; must be less than length().
+         * @return A reference to the character.
+         */
+        constexpr char& operator[](std::size_t index)
+        {
+            return _strData[index];
+        }
+
+        /**
+         * @brief Gets a character of the string.
+         *
+         * @param index The position of the character; must be less than length().
+         * @return The character.
+         */
+        constexpr char operator[](std::size_t index) const
+        {
+            return _strData[index];
+        }
+
+        /**
+         * @brief Compound append operator.
+         *
+         * @param appendView The characters to append.
+         * @return A reference to the string.
+         */
+        constexpr FixedString& operator+=(StringView appendView)
+        {
+            return append(appendView);
+        }
+
+        /**
+         * @brief Compound append operator.
+         *
+         * @param ch The character to append.
+         * @return A reference to the string.
+         */
+        constexpr FixedString& operator+=(char ch)
+        {
+            push_back(ch);
+            return *this;
+        }
+
+        /**
+         * @brief Comparison operator.
+         *
+         * @param compareView The characters to compare to.
+         * @return true if the characters are equal, false otherwise.
+         */
+        constexpr bool operator==(StringView compareView) const
+        {
+            if (_strLength != compareView.length())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < _strLength; ++i)
+            {
+                if (_strData[i] != compareView[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Comparison operator.
+         *
+         * @param compareView The characters to compare to.
+         * @return true if the characters differ, false otherwise.
+         */
+        constexpr bool operator!=(StringView compareView) const
+        {
+            return !(*this == compareView);
+        }
+
+        /**
+         * @brief Conversion operator.
+         *
+         * @return A view of the characters of the string.
+         */
+        constexpr operator StringView() const noexcept
+        {
+            return StringView(_strData, _strLength);
+        }
+
+        // #endregion
+
+        // #region Public Methods
+
+        /**
+         * @brief Appends characters to the end of the string.
+         *
+         * @param appendView The characters to append; they must fit in the remaining capacity.
+         * @return A reference to the string.
+         */
+        constexpr FixedString& append(StringView appendView)
+        {
+            assert(_strLength + appendView.length() <= Capacity);
+            for (std::size_t i = 0; i < appendView.length(); ++i)
+            {
+                _strData[_strLength++] = appendView[i];
+            }
+            _strData[_strLength] = '\0';
+            return *this;
+        }
+
+        /**
+         * @brief Appends a single character to the end of the string.
+         *
+         * @param ch The character to append; the string must not be full.
+         */
+        constexpr void push_back(char ch)
+        {
+            assert(_strLength < Capacity);
+            _strData[_strLength++] = ch;
+            _strData[_strLength] = '\0';
+        }
+
+        /**
+         * @brief Empties the string.
+         */
+        constexpr void clear() noexcept
+        {
+            _strLength = 0;
+            _strData[0] = '\0';
+        }
+
+        /**
+         * @brief Gets the characters as a null-terminated C-string.
+         *
+         * @return A pointer to the characters.
+         */
+        constexpr const char* c_str() const noexcept
+        {
+            return _strData;
+        }
+
+        /**
+         * @brief Gets the characters.
+         *
+         * @return A pointer to the characters.
+         */
+        constexpr const char* data() const noexcept
+        {
+            return _strData;
+        }
+
+        /**
+         * @brief Gets the length of the string.
+         *
+         * @return The number of characters.
+         */
+        constexpr std::size_t length() const noexcept
+        {
+            return _strLength;
+        }
+
+        /**
+         * @brief Gets the capacity of the string.
+         *
+         * @return The largest number of characters the string can hold.
+         */
+        static constexpr std::size_t capacity() noexcept
+        {
+            return Capacity;
+        }
+
+        /**
+         * @brief Checks whether the string is empty.
+         *
+         * @return true if the string has no characters, false otherwise.
+         */
+        constexpr bool empty() const noexcept
+        {
+            return _strLength == 0;
+        }
+
+        constexpr const char* begin() const noexcept { return _strData; }
+        constexpr const char* end() const noexcept { return _strData + _strLength; }
+
+        // #endregion
+
+        /**
+         * @brief Writes the characters to an output stream, like a StringView.
+         *
+         * @param outputStream The stream to write to.
+         * @param outputString The string to write.
+         * @return A reference to the stream.
+         */
+        friend std::ostream& operator<<(std::ostream& outputStream, const FixedString& outputString)
+        {
+            return outputStream << StringView(outputString);
+        }
+
+    private:
+        char _strData[Capacity + 1];    ///< The characters, followed by a null character.
+        std::size_t _strLength;         ///< The number of characters.
+    };
+
+    /**
+     * @brief Makes a FixedString exactly as large as a string literal.
+     *
+     * @param literal The literal.
+     * @return A FixedString holding the literal, e.g. `constexpr auto name = makeFixedString("name");`.
+     */
+    template <std::size_t LiteralSize>
+    constexpr FixedString<LiteralSize - 1> makeFixedString(const char (&literal)[LiteralSize]) noexcept
+    {
+        return FixedString<LiteralSize - 1>(literal);
+    }
+}
+
+#endif // FIXED_STRING_HPP
@@ -0,0 +1,208 @@
+/**************************************************************************************************
+ * @file Hash.hpp
+ *
+ * @brief A fast, non-cryptographic hash for strings.
+ *
+ * This file contains hashBytes(), a 64-bit hash in the style of wyhash: input is
+ * consumed 16 or 48 bytes at a time and mixed with 64x64->128-bit multiplications,
+ * so long strings hash at several bytes per cycle and short strings in a handful
+ * of instructions. It is meant for hash tables, not for security.
+ * hashBytesIgnoreCase() is the same hash with ASCII letters lowercased as they
+ * are read, for case-insensitive keys.
+ *
+ **************************************************************************************************/
+
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace UserDefined
+{
+    namespace Detail
+    {
+        static constexpr std::uint64_t hashSecret[4] = {
+            0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+        };
+
+        /**
+         * @brief Multiplies two 64-bit values into a 128-bit product, returning the low half in a and the high half in b.
+         */
+        inline void multiply128(std::uint64_t& a, std::uint64_t& b)
+        {
+#if defined(__SIZEOF_INT128__)
+            unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+            a = static_cast<std::uint64_t>(product);
+            b = static_cast<std::uint64_t>(product >> 64);
+#else
+            std::uint64_t aHigh = a >> 32, aLow = static_cast<std::uint32_t>(a);
+            std::uint64_t bHigh = b >> 32, bLow = static_cast<std::uint32_t>(b);
+            std::uint64_t high = aHigh * bHigh, middle0 = aHigh * bLow, middle1 = aLow * bHigh, low = aLow * bLow;
+            std::uint64_t carry = ((low >> 32) + static_cast<std::uint32_t>(middle0) + static_cast<std::uint32_t>(middle1)) >> 32;
+            a = low + (middle0 << 32) + (middle1 << 32);
+            b = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+#endif
+        }
+
+        /**
+         * @brief Folds the 128-bit product of two values into 64 bits.
+         */
+        inline std::uint64_t mix(std::uint64_t a, std::uint64_t b)
+        {
+            multiply128(a, b);
+            return a ^ b;
+        }
+
+        inline std::uint64_t read64(const unsigned char* data)
+        {
+            std::uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        inline std::uint64_t read32(const unsigned char* data)
+        {
+            std::uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        /**
+         * @brief Reads 1 to 3 bytes as one value (the first, middle and last byte).
+         */
+        inline std::uint64_t read1To3(const unsigned char* data, std::size_t length)
+        {
+            return (static_cast<std::uint64_t>(data[0]) << 16) | (static_cast<std::uint64_t>(data[length >> 1]) << 8) | data[length - 1];
+        }
+
+        /**
+         * @brief Leaves the bytes read by the hash as they are.
+         */
+        struct IdentityFold
+        {
+            static std::uint64_t apply(std::uint64_t word) { return word; }
+        };
+
+        /**
+         * @brief Lowercases the ASCII letters among the bytes read by the hash, eight at a time.
+         *
+         * Adding to the low seven bits of each byte cannot carry into the next byte, so bit 7
+         * tells whether the byte reached 'A', and separately whether it passed 'Z'.
+         */
+        struct AsciiLowercaseFold
+        {
+            static std::uint64_t apply(std::uint64_t word)
+            {
+                const std::uint64_t ones = 0x0101010101010101ULL;
+                std::uint64_t lowBits = word & (0x7F * ones);
+                std::uint64_t atLeastA = lowBits + (0x80 - 'A') * ones;
+                std::uint64_t aboveZ = lowBits + (0x80 - 'Z' - 1) * ones;
+                std::uint64_t upper = (atLeastA ^ aboveZ) & ~word & (0x80 * ones);
+                return word | (upper >> 2);
+            }
+        };
+
+        /**
+         * @brief Hashes a run of bytes, passing every word read through Fold::apply().
+         */
+        template <typename Fold>
+        inline std::uint64_t hashFolded(const unsigned char* data, std::size_t length, std::uint64_t seed)
+        {
+            std::uint64_t a;
+            std::uint64_t b;
+
+            seed ^= mix(seed ^ hashSecret[0], hashSecret[1]);
+
+            if (length <= 16)
+            {
+                if (length >= 4)
+                {
+                    // Two (possibly overlapping) 4-byte reads from each end cover every byte.
+                    std::size_t step = (length >> 3) << 2;
+                    a = Fold::apply((read32(data) << 32) | read32(data + step));
+                    b = Fold::apply((read32(data + length - 4) << 32) | read32(data + length - 4 - step));
+                }
+                else if (length > 0)
+                {
+                    a = Fold::apply(read1To3(data, length));
+                    b = 0;
+                }
+                else
+                {
+                    a = b = 0;
+                }
+            }
+            else
+            {
+                std::size_t remaining = length;
+                if (remaining > 48)
+                {
+                    // Three independent lanes keep the multipliers busy on long inputs.
+                    std::uint64_t lane1 = seed;
+                    std::uint64_t lane2 = seed;
+                    do
+                    {
+                        seed = mix(Fold::apply(read64(data)) ^ hashSecret[1], Fold::apply(read64(data + 8)) ^ seed);
+                        lane1 = mix(Fold::apply(read64(data + 16)) ^ hashSecret[2], Fold::apply(read64(data + 24)) ^ lane1);
+                        lane2 = mix(Fold::apply(read64(data + 32)) ^ hashSecret[3], Fold::apply(read64(data + 40)) ^ lane2);
+                        data += 48;
+                        remaining -= 48;
+                    } while (remaining > 48);
+                    seed ^= lane1 ^ lane2;
+                }
+
+                while (remaining > 16)
+                {
+                    seed = mix(Fold::apply(read64(data)) ^ hashSecret[1], Fold::apply(read64(data + 8)) ^ seed);
+                    data += 16;
+                    remaining -= 16;
+                }
+
+                // The last 16 bytes, overlapping what was already consumed if needed.
+                a = Fold::apply(read64(data + remaining - 16));
+                b = Fold::apply(read64(data + remaining - 8));
+            }
+
+            a ^= hashSecret[1];
+            b ^= seed;
+            multiply128(a, b);
+            return mix(a ^ hashSecret[0] ^ length, b ^ hashSecret[1]);
+        }
+    }
+
+    /**
+     * @brief Hashes a run of bytes.
+     *
+     * The result only depends on the bytes, the length and the seed, never on the
+     * address or alignment of the data.
+     *
+     * @param input The bytes to hash.
+     * @param length The number of bytes.
+     * @param seed An optional seed, to get independent hash functions.
+     * @return The 64-bit hash value.
+     */
+    inline std::uint64_t hashBytes(const void* input, std::size_t length, std::uint64_t seed = 0)
+    {
+        return Detail::hashFolded<Detail::IdentityFold>(static_cast<const unsigned char*>(input), length, seed);
+    }
+
+    /**
+     * @brief Hashes a run of bytes, ignoring the case of ASCII letters.
+     *
+     * The letters are lowercased as they are read, without a copy; the result is the
+     * hashBytes() of the bytes with every ASCII letter lowercased.
+     *
+     * @param input The bytes to hash.
+     * @param length The number of bytes.
+     * @param seed An optional seed, to get independent hash functions.
+     * @return The 64-bit hash value.
+     */
+    inline std::uint64_t hashBytesIgnoreCase(const void* input, std::size_t length, std::uint64_t seed = 0)
+    {
+        return Detail::hashFolded<Detail::AsciiLowercaseFold>(static_cast<const unsigned char*>(input), length, seed);
+    }
+}
+
+#endif // HASH_HPP
@@ -0,0 +1,218 @@
+/**************************************************************************************************
+ * @file Instrumentation.hpp
+ *
+ * @brief Opt-in, per-thread counters of the allocations, copies and moves made by String.
+ *
+ * This file contains the counters String reports into when the program is compiled
+ * with USERDEFINED_STRING_INSTRUMENTATION defined (e.g. -DUSERDEFINED_STRING_INSTRUMENTATION),
+ * and a Snapshot that measures what a region of code did. Without the macro the
+ * reporting functions are empty and String compiles to exactly the same code as
+ * before; snapshots still work but report zeros.
+ *
+ * The macro must be set for the whole program (e.g. in the CXXFLAGS of the Makefile),
+ * never in some translation units only: the inline functions of String would then have
+ * two definitions, and the linker would keep either one. To catch such a mix, the mode
+ * is part of the symbol names: the reporting functions live in an inline namespace
+ * named after it, and an instrumented String carries the ABI tag "instrumented", so a
+ * function taking a String that is compiled in one mode and called from the other
+ * fails to link instead of miscounting.
+ *
+ **************************************************************************************************/
+
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <cstddef>
+
+#ifdef USERDEFINED_STRING_INSTRUMENTATION
+#define USERDEFINED_INSTRUMENTATION_ABI __attribute__((abi_tag("instrumented")))
+#else
+#define USERDEFINED_INSTRUMENTATION_ABI
+#endif
+
+namespace UserDefined
+{
+    namespace Instrumentation
+    {
+        /// Whether String reports into the counters in this program.
+#ifdef USERDEFINED_STRING_INSTRUMENTATION
+        static constexpr bool enabled = true;
+#else
+        static constexpr bool enabled = false;
+#endif
+
+        /**
+         * @struct Counters
+         * @brief What the strings of one thread did.
+         *
+         * Bytes are those requested from the memory resource (capacity plus the null character).
+         * The live byte count is signed because a buffer allocated by one thread may be freed
+         * by another, which counts the deallocation. Buffers a string adopts or releases count
+         * as allocated or freed by it, so that the live bytes stay balanced.
+         */
+        struct Counters
+        {
+            std::size_t allocations;        ///< Heap buffers allocated.
+            std::size_t deallocations;      ///< Heap buffers freed.
+            std::size_t allocatedBytes;     ///< Bytes allocated.
+            std::size_t deallocatedBytes;   ///< Bytes freed.
+            std::size_t copies;             ///< Strings copy-constructed or copy-assigned.
+            std::size_t moves;              ///< Strings move-constructed or move-assigned.
+            std::ptrdiff_t liveBytes;       ///< Bytes allocated and not freed yet.
+            std::ptrdiff_t peakLiveBytes;   ///< The highest liveBytes reached (in a Snapshot delta: above the starting value).
+        };
+
+        /**
+         * @brief Gets the counters of the calling thread.
+         *
+         * @return A reference to the counters; they start at zero in every thread.
+         */
+        inline Counters& threadCounters() noexcept
+        {
+            static thread_local Counters counters = {};
+            return counters;
+        }
+
+        // #region Reporting (called by String)
+
+#ifdef USERDEFINED_STRING_INSTRUMENTATION
+        inline namespace Enabled
+        {
+            /**
+             * @brief Records the allocation of a heap buffer.
+             *
+             * @param bytes The size of the buffer.
+             */
+            inline void recordAllocation(std::size_t bytes) noexcept
+            {
+                Counters& counters = threadCounters();
+                counters.allocations++;
+                counters.allocatedBytes += bytes;
+                counters.liveBytes += static_cast<std::ptrdiff_t>(bytes);
+                if (counters.liveBytes > counters.peakLiveBytes)
+                {
+                    counters.peakLiveBytes = counters.liveBytes;
+                }
+            }
+
+            /**
+             * @brief Records the release of a heap buffer.
+             *
+             * @param bytes The size of the buffer.
+             */
+            inline void recordDeallocation(std::size_t bytes) noexcept
+            {
+                Counters& counters = threadCounters();
+                counters.deallocations++;
+                counters.deallocatedBytes += bytes;
+                counters.liveBytes -= static_cast<std::ptrdiff_t>(bytes);
+            }
+
+            /**
+             * @brief Records a string copy.
+             */
+            inline void recordCopy() noexcept
+            {
+                threadCounters().copies++;
+            }
+
+            /**
+             * @brief Records a string move.
+             */
+            inline void recordMove() noexcept
+            {
+                threadCounters().moves++;
+            }
+        }
+#else
+        inline namespace Disabled
+        {
+            inline void recordAllocation(std::size_t) noexcept
+            {
+            }
+
+            inline void recordDeallocation(std::size_t) noexcept
+            {
+            }
+
+            inline void recordCopy() noexcept
+            {
+            }
+
+            inline void recordMove() noexcept
+            {
+            }
+        }
+#endif
+
+        // #endregion
+
+        /**
+         * @class Snapshot
+         * @brief Measures what the strings of the calling thread do while it is alive.
+         *
+         * @code
+         * Instrumentation::Snapshot snapshot;
+         * parseRequest(input);
+         * Instrumentation::Counters cost = snapshot.delta();   // allocations, bytes, copies... of parseRequest()
+         * @endcode
+         *
+         * Snapshots may be nested. A snapshot belongs to the thread that created it and must
+         * be destroyed in reverse order of creation, like any local variable.
+         */
+        class Snapshot
+        {
+        public:
+            /**
+             * @brief Starts measuring.
+             */
+            Snapshot() noexcept
+                : _start(threadCounters())
+            {
+                // Track the peak of this region from the current level; the outer peak is restored on destruction.
+                threadCounters().peakLiveBytes = _start.liveBytes;
+            }
+
+            Snapshot(const Snapshot&) = delete;
+            Snapshot& operator=(const Snapshot&) = delete;
+
+            /**
+             * @brief Stops measuring, folding the peak of the region into the enclosing one.
+             */
+            ~Snapshot()
+            {
+                Counters& counters = threadCounters();
+                if (_start.peakLiveBytes > counters.peakLiveBytes)
+                {
+                    counters.peakLiveBytes = _start.peakLiveBytes;
+                }
+            }
+
+            /**
+             * @brief Gets what happened since the snapshot was taken.
+             *
+             * @return The difference of every counter; peakLiveBytes is the highest number of
+             *         live bytes reached above the level at the start, and liveBytes the net change.
+             */
+            Counters delta() const noexcept
+            {
+                const Counters& counters = threadCounters();
+                Counters difference;
+                difference.allocations = counters.allocations - _start.allocations;
+                difference.deallocations = counters.deallocations - _start.deallocations;
+                difference.allocatedBytes = counters.allocatedBytes - _start.allocatedBytes;
+                difference.deallocatedBytes = counters.deallocatedBytes - _start.deallocatedBytes;
+                difference.copies = counters.copies - _start.copies;
+                difference.moves = counters.moves - _start.moves;
+                difference.liveBytes = counters.liveBytes - _start.liveBytes;
+                difference.peakLiveBytes = counters.peakLiveBytes - _start.liveBytes;
+                return difference;
+            }
+
+        private:
+            Counters _start;    ///< The counters when the snapshot was taken.
+        };
+    }
+}
+
+#endif // INSTRUMENTATION_HPP
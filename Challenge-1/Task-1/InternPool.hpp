@@ -0,0 +1,342 @@
+/**************************************************************************************************
+ * @file InternPool.hpp
+ *
+ * @brief A thread-safe string interning pool.
+ *
+ * This file contains the definition of InternPool, which stores one copy of each
+ * distinct string it is given and hands out InternedString handles to it. Equal
+ * strings get the same handle, so handles compare with a single pointer comparison
+ * and carry a precomputed hash.
+ *
+ **************************************************************************************************/
+
+#ifndef INTERN_POOL_HPP
+#define INTERN_POOL_HPP
+
+#include "String.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace UserDefined
+{
+    class InternPool;
+
+    namespace Detail
+    {
+        /**
+         * @struct InternEntry
+         * @brief The header of an interned string; the null-terminated characters follow it in the arena.
+         */
+        struct InternEntry
+        {
+            std::size_t hash;       ///< The precomputed hash of the characters.
+            std::size_t length;     ///< The number of characters.
+
+            const char* data() const
+            {
+                return reinterpret_cast<const char*>(this + 1);
+            }
+        };
+    }
+
+    /**
+     * @class InternedString
+     * @brief A handle to a string stored in an InternPool.
+     *
+     * Handles are small, trivially copyable and valid as long as the pool that made them.
+     * Two handles from the same pool are equal exactly when their strings are equal,
+     * so comparison is a pointer comparison and hash() is a stored value.
+     */
+    class InternedString
+    {
+    public:
+        /**
+         * @brief Default constructor.
+         *
+         * Constructs a handle to the empty string. It is only equal to other default-constructed handles.
+         */
+        InternedString() noexcept
+            : _entry(nullptr)
+        {
+        }
+
+        bool operator==(const InternedString& compareString) const { return _entry == compareString._entry; }
+        bool operator!=(const InternedString& compareString) const { return _entry != compareString._entry; }
+
+        /**
+         * @brief Gets the length of the string.
+         *
+         * @return The length of the string.
+         */
+        std::size_t length() const
+        {
+            return _entry ? _entry->length : 0;
+        }
+
+        /**
+         * @brief Gets the string as a C-string.
+         *
+         * @return The string as a C-string, stored in the pool.
+         */
+        const char* c_str() const
+        {
+            return _entry ? _entry->data() : "";
+        }
+
+        /**
+         * @brief Gets the hash of the string, computed once when it was interned.
+         *
+         * @return The hash of the string.
+         */
+        std::size_t hash() const
+        {
+            return _entry ? _entry->hash : 0;
+        }
+
+        /**
+         * @brief Inserts the string into an output stream.
+         *
+         * @param outputStream The output stream.
+         * @param outputString The string to insert.
+         *
+         * @return The output stream.
+         */
+        friend std::ostream& operator<<(std::ostream& outputStream, const InternedString& outputString)
+        {
+            return outputStream.write(outputString.c_str(), static_cast<std::streamsize>(outputString.length()));
+        }
+
+    private:
+        friend class InternPool;
+
+        explicit InternedString(const Detail::InternEntry* entry)
+            : _entry(entry)
+        {
+        }
+
+        const Detail::InternEntry* _entry;      ///< The interned entry (nullptr for the empty handle).
+    };
+
+    /**
+     * @class InternPool
+     * @brief A thread-safe table of interned strings.
+     *
+     * The table is split into shards selected by hash, each with its own reader-writer
+     * lock, so lookups of strings that are already interned only take a shared lock and
+     * threads interning different strings rarely contend. Interned characters are copied
+     * into a MonotonicArena owned by their shard and are only freed, all at once, when
+     * the pool is destroyed.
+     */
+    class InternPool
+    {
+    public:
+
+        // #region Constructors/Destruction
+
+        InternPool() = default;
+        InternPool(const InternPool&) = delete;
+        InternPool& operator=(const InternPool&) = delete;
+
+        // #endregion
+
+        // #region Public Methods
+
+        /**
+         * @brief Interns a run of characters.
+         *
+         * @param characters The characters to intern.
+         * @return The handle of the interned string; equal strings always get the same handle.
+         */
+        InternedString intern(StringView characters)
+        {
+            const char* data = characters.data();
+            std::size_t length = characters.length();
+            std::size_t hash = static_cast<std::size_t>(hashBytes(data, length));
+            Shard& shard = _shards[hash % _shardCount];
+
+            {
+                std::shared_lock<std::shared_timed_mutex> readLock(shard.mutex);
+                if (const Detail::InternEntry* entry = shard.find(hash, data, length))
+                {
+                    return InternedString(entry);
+                }
+            }
+
+            std::lock_guard<std::shared_timed_mutex> writeLock(shard.mutex);
+            if (const Detail::InternEntry* entry = shard.find(hash, data, length))
+            {
+                return InternedString(entry);
+            }
+            return InternedString(shard.insert(hash, data, length));
+        }
+
+        /**
+         * @brief Interns a run of characters.
+         *
+         * @param data The characters to intern.
+         * @param length The number of characters.
+         * @return The handle of the interned string.
+         */
+        InternedString intern(const char* data, std::size_t length)
+        {
+            return intern(StringView(data, length));
+        }
+
+        /**
+         * @brief Interns a String.
+         *
+         * @param inputString The string to intern.
+         * @return The handle of the interned string.
+         */
+        InternedString intern(const String& inputString)
+        {
+            return intern(StringView(inputString));
+        }
+
+        /**
+         * @brief Interns a C-string.
+         *
+         * @param inputString The C-string to intern.
+         * @return The handle of the interned string.
+         */
+        InternedString intern(const char* inputString)
+        {
+            return intern(StringView(inputString));
+        }
+
+        /**
+         * @brief Gets the number of distinct strings in the pool.
+         *
+         * @return The number of interned strings.
+         */
+        std::size_t size() const
+        {
+            std::size_t totalCount = 0;
+            for (const Shard& shard : _shards)
+            {
+                std::shared_lock<std::shared_timed_mutex> readLock(shard.mutex);
+                totalCount += shard.count;
+            }
+            return totalCount;
+        }
+
+        // #endregion
+
+    private:
+        static constexpr std::size_t _shardCount = 16;              ///< The number of independently locked shards.
+        static constexpr std::size_t _arenaBlockSize = 64 * 1024;   ///< The size of the first arena block.
+
+        /**
+         * @struct Shard
+         * @brief One lock, an open-addressing table of entries and the arena holding them.
+         */
+        struct Shard
+        {
+            /**
+             * @brief Looks up a string. The caller must hold the shard lock.
+             *
+             * @return The entry of the string, or nullptr if it is not interned.
+             */
+            const Detail::InternEntry* find(std::size_t hash, const char* data, std::size_t length) const
+            {
+                if (slots.empty())
+                {
+                    return nullptr;
+                }
+
+                std::size_t mask = slots.size() - 1;
+                for (std::size_t index = (hash / _shardCount) & mask; slots[index]; index = (index + 1) & mask)
+                {
+                    const Detail::InternEntry* entry = slots[index];
+                    if (entry->hash == hash && entry->length == length && std::equal(data, data + length, entry->data()))
+                    {
+                        return entry;
+                    }
+                }
+                return nullptr;
+            }
+
+            /**
+             * @brief Copies a string into the arena and adds it to the table. The caller must hold the lock exclusively.
+             *
+             * @return The new entry.
+             */
+            const Detail::InternEntry* insert(std::size_t hash, const char* data, std::size_t length)
+            {
+                if (2 * (count + 1) > slots.size())
+                {
+                    rehash(slots.empty() ? 64 : 2 * slots.size());
+                }
+
+                auto entry = static_cast<Detail::InternEntry*>(arena.allocate(sizeof(Detail::InternEntry) + length + 1, alignof(Detail::InternEntry)));
+                entry->hash = hash;
+                entry->length = length;
+                char* entryData = reinterpret_cast<char*>(entry + 1);
+                std::copy(data, data + length, entryData);
+                entryData[length] = '\0';
+
+                place(entry);
+                count++;
+                return entry;
+            }
+
+            /**
+             * @brief Puts an entry in the first free slot of its probe sequence.
+             */
+            void place(const Detail::InternEntry* entry)
+            {
+                std::size_t mask = slots.size() - 1;
+                std::size_t index = (entry->hash / _shardCount) & mask;
+                while (slots[index])
+                {
+                    index = (index + 1) & mask;
+                }
+                slots[index] = entry;
+            }
+
+            /**
+             * @brief Moves all entries to a table with the given number of slots (a power of two).
+             */
+            void rehash(std::size_t slotCount)
+            {
+                std::vector<const Detail::InternEntry*> oldSlots(slotCount, nullptr);
+                oldSlots.swap(slots);
+                for (const Detail::InternEntry* entry : oldSlots)
+                {
+                    if (entry)
+                    {
+                        place(entry);
+                    }
+                }
+            }
+
+            mutable std::shared_timed_mutex mutex;              ///< Guards the table and the arena.
+            std::vector<const Detail::InternEntry*> slots;      ///< Open-addressing table (size is a power of two).
+            std::size_t count = 0;                              ///< The number of entries in the table.
+            MonotonicArena arena{ _arenaBlockSize };             ///< Holds the entries; freed with the pool.
+        };
+
+        Shard _shards[_shardCount];     ///< The shards, selected by hash.
+    };
+}
+
+namespace std
+{
+    /**
+     * @brief Hash specialization returning the precomputed hash of an interned string.
+     */
+    template <>
+    struct hash<UserDefined::InternedString>
+    {
+        std::size_t operator()(const UserDefined::InternedString& internedString) const noexcept
+        {
+            return internedString.hash();
+        }
+    };
+}
+
+#endif // INTERN_POOL_HPP
@@ -0,0 +1,163 @@
+/**************************************************************************************************
+ * @file Join.hpp
+ *
+ * @brief Joining many strings with a separator in a single allocation.
+ *
+ * This file contains join(), the inverse of split(): it sums the lengths of the
+ * pieces first, allocates the result once and copies every piece and separator
+ * straight into place, instead of building it with one operator+ per piece. Very
+ * large results may be copied by several threads, each filling its own part of
+ * the output.
+ *
+ **************************************************************************************************/
+
+#ifndef JOIN_HPP
+#define JOIN_HPP
+
+#include "String.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace UserDefined
+{
+    namespace Detail
+    {
+        static constexpr std::size_t minimumParallelJoinLength = 1 << 20;  ///< The least output per thread worth a thread.
+
+        /**
+         * @brief Copies a number of characters, allowing an empty source with no storage.
+         */
+        inline char* copyCharacters(char* destination, const char* source, std::size_t length)
+        {
+            if (length != 0)
+            {
+                std::memcpy(destination, source, length);
+            }
+            return destination + length;
+        }
+
+        /**
+         * @brief Writes the bytes [begin, end) of the joined output.
+         *
+         * @param pieces The pieces.
+         * @param offsets The position of each piece in the output.
+         * @param separator The separator written between pieces.
+         * @param begin The first output position to write.
+         * @param end The output position to stop at.
+         * @param output The whole output buffer.
+         */
+        inline void copyJoinedRange(const std::vector<StringView>& pieces, const std::vector<std::size_t>& offsets, StringView separator,
+                                    std::size_t begin, std::size_t end, char* output)
+        {
+            // The last piece starting at or before begin (empty pieces before it contribute nothing).
+            std::size_t piece = static_cast<std::size_t>(std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin()) - 1;
+            std::size_t position = begin;
+
+            for (; position < end; ++piece)
+            {
+                std::size_t pieceStart = offsets[piece];
+                std::size_t pieceEnd = pieceStart + pieces[piece].length();
+                if (position < pieceEnd)
+                {
+                    std::size_t count = std::min(end, pieceEnd) - position;
+                    copyCharacters(output + position, pieces[piece].data() + (position - pieceStart), count);
+                    position += count;
+                }
+                if (piece + 1 < pieces.size() && position < end)
+                {
+                    std::size_t count = std::min(end, pieceEnd + separator.length()) - position;
+                    copyCharacters(output + position, separator.data() + (position - pieceEnd), count);
+                    position += count;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Joins strings with a separator, allocating the result once.
+     *
+     * The range is traversed twice, once to add up the lengths and once to copy, so it
+     * must be a container or another range that can be iterated more than once. Its
+     * elements may be anything that converts to a StringView (Strings, std::strings,
+     * C-strings, StringViews, split() tokens, ...).
+     *
+     * With more than one thread, results of at least 1 MB per thread are cut into equal
+     * byte ranges, and each thread copies the pieces and separators that fall into its
+     * range, so even a single huge piece is copied in parallel.
+     *
+     * @param pieces The strings to join.
+     * @param separator The characters written between consecutive pieces.
+     * @param threadCount The number of threads to copy with, including the calling thread.
+     * @return The joined string.
+     */
+    template <typename Range>
+    String join(const Range& pieces, StringView separator, std::size_t threadCount = 1)
+    {
+        std::size_t pieceCount = 0;
+        std::size_t totalLength = 0;
+        for (const auto& piece : pieces)
+        {
+            totalLength += StringView(piece).length();
+            pieceCount++;
+        }
+        if (pieceCount != 0)
+        {
+            totalLength += (pieceCount - 1) * separator.length();
+        }
+
+        String joined;
+        threadCount = std::min(threadCount, totalLength / Detail::minimumParallelJoinLength);
+        if (threadCount <= 1)
+        {
+            joined.resize_and_overwrite(totalLength, [&pieces, separator](char* output, std::size_t length) {
+                bool first = true;
+                for (const auto& piece : pieces)
+                {
+                    if (!first)
+                    {
+                        output = Detail::copyCharacters(output, separator.data(), separator.length());
+                    }
+                    first = false;
+                    StringView view(piece);
+                    output = Detail::copyCharacters(output, view.data(), view.length());
+                }
+                return length;
+            });
+            return joined;
+        }
+
+        std::vector<StringView> views;
+        std::vector<std::size_t> offsets;
+        views.reserve(pieceCount);
+        offsets.reserve(pieceCount);
+        std::size_t offset = 0;
+        for (const auto& piece : pieces)
+        {
+            views.emplace_back(piece);
+            offsets.push_back(offset);
+            offset += views.back().length() + separator.length();
+        }
+
+        joined.resize_and_overwrite(totalLength, [&views, &offsets, separator, threadCount](char* output, std::size_t length) {
+            std::vector<std::thread> threads;
+            for (std::size_t t = 1; t < threadCount; ++t)
+            {
+                threads.emplace_back([&views, &offsets, separator, output, length, threadCount, t]() {
+                    Detail::copyJoinedRange(views, offsets, separator, t * length / threadCount, (t + 1) * length / threadCount, output);
+                });
+            }
+            Detail::copyJoinedRange(views, offsets, separator, 0, length / threadCount, output);
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            return length;
+        });
+        return joined;
+    }
+}
+
+#endif // JOIN_HPP
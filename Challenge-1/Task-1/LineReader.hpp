@@ -0,0 +1,174 @@
+/**************************************************************************************************
+ * @file LineReader.hpp
+ *
+ * @brief A buffered reader that splits an input stream into lines.
+ *
+ * This file contains the definition of LineReader, which reads an input stream in
+ * large chunks and finds the line ends with the vectorized character search of
+ * Simd.hpp. Lines are handed out either as StringViews into the read buffer (no
+ * copy at all) or copied into a String that keeps its capacity from line to line,
+ * so reading a multi-gigabyte log performs a handful of allocations in total.
+ *
+ **************************************************************************************************/
+
+#ifndef LINE_READER_HPP
+#define LINE_READER_HPP
+
+#include "String.hpp"
+
+#include <cstring>
+#include <istream>
+#include <memory>
+
+namespace UserDefined
+{
+    /**
+     * @class LineReader
+     * @brief Reads lines from an input stream in bulk.
+     *
+     * Lines are separated by '\n', which is not part of the returned line; a last line
+     * without a newline is returned as well. The reader owns a read buffer of a fixed
+     * size, which only grows when a single line does not fit in it.
+     *
+     * The reader reads ahead, so the stream should not be used directly while a reader
+     * is attached to it.
+     */
+    class LineReader
+    {
+    public:
+
+        // #region Constructors/Destruction
+
+        /**
+         * @brief Constructs a reader for an input stream.
+         *
+         * @param inputStream The stream to read from; it must outlive the reader.
+         * @param bufferSize The size of the read buffer (the size of each read from the stream).
+         */
+        explicit LineReader(std::istream& inputStream, std::size_t bufferSize = 64 * 1024)
+            : _inputStream(inputStream)
+            , _buffer(new char[bufferSize > 0 ? bufferSize : 1])
+            , _bufferSize(bufferSize > 0 ? bufferSize : 1)
+            , _begin(0)
+            , _end(0)
+            , _scanned(0)
+            , _endOfInput(false)
+        {
+        }
+
+        LineReader(const LineReader&) = delete;
+        LineReader& operator=(const LineReader&) = delete;
+
+        // #endregion
+
+        // #region Public Methods
+
+        /**
+         * @brief Reads the next line as a view into the read buffer.
+         *
+         * No characters are copied. The view is only valid until the next call to readLine().
+         *
+         * @param line Receives the line, without its newline.
+         * @return true if a line was read, false at the end of the input.
+         */
+        bool readLine(StringView& line)
+        {
+            for (;;)
+            {
+                std::size_t found = Simd::findChar(_buffer.get() + _scanned, _end - _scanned, '\n');
+                if (found != Simd::notFound)
+                {
+                    std::size_t lineEnd = _scanned + found;
+                    line = StringView(_buffer.get() + _begin, lineEnd - _begin);
+                    _begin = _scanned = lineEnd + 1;
+                    return true;
+                }
+                _scanned = _end;
+
+                if (_endOfInput || !_fill())
+                {
+                    if (_begin == _end)
+                    {
+                        return false;
+                    }
+
+                    // The last line has no newline.
+                    line = StringView(_buffer.get() + _begin, _end - _begin);
+                    _begin = _scanned = _end;
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * @brief Reads the next line into a String.
+         *
+         * The characters are copied into the existing buffer of the string, which only
+         * allocates when the line is longer than any line it held before.
+         *
+         * @param line Receives the line, without its newline.
+         * @return true if a line was read, false at the end of the input (line is left unchanged).
+         */
+        bool readLine(String& line)
+        {
+            StringView lineView;
+            if (!readLine(lineView))
+            {
+                return false;
+            }
+
+            line.assign(lineView);
+            return true;
+        }
+
+        // #endregion
+
+    private:
+        /**
+         * @brief Reads the next chunk of the stream into the buffer.
+         *
+         * The part of the buffer holding the unfinished line is moved to the front first,
+         * and the buffer is doubled when that line already fills it.
+         *
+         * @return true if any characters were read, false at the end of the input.
+         */
+        bool _fill()
+        {
+            if (_begin > 0)
+            {
+                std::memmove(_buffer.get(), _buffer.get() + _begin, _end - _begin);
+                _end -= _begin;
+                _scanned -= _begin;
+                _begin = 0;
+            }
+
+            if (_end == _bufferSize)
+            {
+                std::unique_ptr<char[]> newBuffer(new char[2 * _bufferSize]);
+                std::memcpy(newBuffer.get(), _buffer.get(), _end);
+                _buffer.swap(newBuffer);
+                _bufferSize *= 2;
+            }
+
+            _inputStream.read(_buffer.get() + _end, static_cast<std::streamsize>(_bufferSize - _end));
+            std::size_t readCount = static_cast<std::size_t>(_inputStream.gcount());
+            _end += readCount;
+
+            if (!_inputStream)
+            {
+                _endOfInput = true;
+            }
+            return readCount > 0;
+        }
+
+        std::istream& _inputStream;         ///< The stream the lines are read from.
+        std::unique_ptr<char[]> _buffer;    ///< The read buffer.
+        std::size_t _bufferSize;            ///< The size of the read buffer.
+        std::size_t _begin;                 ///< The start of the first line not returned yet.
+        std::size_t _end;                   ///< The end of the characters read so far.
+        std::size_t _scanned;               ///< How far the buffer was searched for a newline.
+        bool _endOfInput;                   ///< Whether the stream has no more characters.
+    };
+}
+
+#endif // LINE_READER_HPP
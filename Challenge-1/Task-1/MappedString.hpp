@@ -0,0 +1,413 @@
+/**************************************************************************************************
+ * @file MappedString.hpp
+ *
+ * @brief Read-only access to a file through a memory mapping.
+ *
+ * This file contains the definition of MappedString, which maps a file into memory
+ * with mmap() and exposes its contents as a read-only string. Opening a file costs
+ * the same whatever its size, as no byte is read until it is used, and the pages
+ * come straight from the page cache, so every process mapping the same file shares
+ * one copy of them.
+ *
+ **************************************************************************************************/
+
+#ifndef MAPPED_STRING_HPP
+#define MAPPED_STRING_HPP
+
+#include "StringView.hpp"
+
+#include <cerrno>
+#include <cstddef>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace UserDefined
+{
+    /**
+     * @class MappedString
+     * @brief The contents of a file, mapped read-only into memory.
+     *
+     * A MappedString offers the query functions of StringView (find(), count(),
+     * substr(), ...) and converts to a StringView for everything else. The characters
+     * are not null-terminated. Views into the mapping are valid as long as the
+     * MappedString that made them; the file should not be truncated while it is mapped,
+     * as touching a page past the new end of the file raises SIGBUS.
+     *
+     * Like a file stream, a MappedString reports failure through isOpen(), with errno
+     * telling why.
+     */
+    class MappedString
+    {
+    public:
+        /**
+         * @brief How the mapping is going to be read, passed to madvise().
+         */
+        enum class Access
+        {
+            Normal,         ///< No particular pattern.
+            Sequential,     ///< Front to back: the kernel reads ahead aggressively and may drop pages behind.
+            Random,         ///< Scattered lookups: no read-ahead.
+            WillNeed        ///< Start reading the whole file in the background now.
+        };
+
+        // #region Constructors/Destruction
+
+        /**
+         * @brief Default constructor.
+         *
+         * Constructs a MappedString that maps nothing.
+         */
+        MappedString() noexcept
+            : _mapping(nullptr)
+            , _length(0)
+            , _isOpen(false)
+        {
+        }
+
+        MappedString(const MappedString&) = delete;
+        MappedString& operator=(const MappedString&) = delete;
+
+        /**
+         * @brief Move constructor.
+         *
+         * @param sourceMapping The mapping to take over; it maps nothing afterwards.
+         */
+        MappedString(MappedString&& sourceMapping) noexcept
+            : _mapping(sourceMapping._mapping)
+            , _length(sourceMapping._length)
+            , _isOpen(sourceMapping._isOpen)
+        {
+            sourceMapping._mapping = nullptr;
+            sourceMapping._length = 0;
+            sourceMapping._isOpen = false;
+        }
+
+        /**
+         * @brief Move assignment operator.
+         *
+         * @param sourceMapping The mapping to take over; it maps nothing afterwards.
+         * @return A reference to the MappedString.
+         */
+        MappedString& operator=(MappedString&& sourceMapping) noexcept
+        {
+            if (this != &sourceMapping)
+            {
+                _unmap();
+                _mapping = sourceMapping._mapping;
+                _length = sourceMapping._length;
+                _isOpen = sourceMapping._isOpen;
+                sourceMapping._mapping = nullptr;
+                sourceMapping._length = 0;
+                sourceMapping._isOpen = false;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destroy the MappedString object, unmapping the file.
+         */
+        ~MappedString()
+        {
+            _unmap();
+        }
+
+        // #endregion
+
+        // #region Public Methods
+
+        /**
+         * @brief Maps a file read-only.
+         *
+         * The file descriptor is closed right away; the mapping keeps the file alive.
+         *
+         * @param path The path of the file.
+         * @param access How the contents are going to be read.
+         * @return The mapping; check isOpen(), and errno if it is false.
+         */
+        static MappedString open(const char* path, Access access = Access::Sequential)
+        {
+            MappedString mapped;
+
+            int fileDescriptor = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fileDescriptor < 0)
+            {
+                return mapped;
+            }
+
+            struct stat fileStatus;
+            if (::fstat(fileDescriptor, &fileStatus) != 0)
+            {
+                _closePreservingErrno(fileDescriptor);
+                return mapped;
+            }
+
+            // An empty file cannot be mapped, but is a perfectly good empty string.
+            if (fileStatus.st_size > 0)
+            {
+                std::size_t length = static_cast<std::size_t>(fileStatus.st_size);
+                void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+                if (mapping == MAP_FAILED)
+                {
+                    _closePreservingErrno(fileDescriptor);
+                    return mapped;
+                }
+                mapped._mapping = mapping;
+                mapped._length = length;
+            }
+            ::close(fileDescriptor);
+
+            mapped._isOpen = true;
+            mapped.advise(access);
+            return mapped;
+        }
+
+        /**
+         * @brief Tells the kernel how the mapping is going to be read from now on.
+         *
+         * @param access The access pattern.
+         * @return true on success, false on error (the hint is only a hint; the mapping stays usable).
+         */
+        bool advise(Access access)
+        {
+            if (!_mapping)
+            {
+                return _isOpen;
+            }
+
+            int advice = MADV_NORMAL;
+            switch (access)
+            {
+                case Access::Sequential: advice = MADV_SEQUENTIAL; break;
+                case Access::Random: advice = MADV_RANDOM; break;
+                case Access::WillNeed: advice = MADV_WILLNEED; break;
+                default: break;
+            }
+            return ::madvise(_mapping, _length, advice) == 0;
+        }
+
+        /**
+         * @brief Checks whether the file was mapped.
+         *
+         * @return true if open() succeeded, false otherwise.
+         */
+        bool isOpen() const
+        {
+            return _isOpen;
+        }
+
+        /**
+         * @brief Gets the contents.
+         *
+         * @return A view of the whole mapping.
+         */
+        StringView view() const
+        {
+            return StringView(data(), _length);
+        }
+
+        /**
+         * @brief Conversion operator.
+         *
+         * @return A view of the whole mapping.
+         */
+        operator StringView() const
+        {
+            return view();
+        }
+
+        /**
+         * @brief Gets a character.
+         *
+         * @param index The position of the character; must be less than length().
+         * @return The character.
+         */
+        char operator[](std::size_t index) const
+        {
+            return data()[index];
+        }
+
+        /**
+         * @brief Gets the characters (not null-terminated).
+         *
+         * @return A pointer to the first character.
+         */
+        const char* data() const
+        {
+            return _mapping ? static_cast<const char*>(_mapping) : "";
+        }
+
+        /**
+         * @brief Gets the length of the contents.
+         *
+         * @return The size of the file when it was mapped.
+         */
+        std::size_t length() const
+        {
+            return _length;
+        }
+
+        /**
+         * @brief Checks whether the contents are empty.
+         *
+         * @return true if there are no characters, false otherwise.
+         */
+        bool empty() const
+        {
+            return _length == 0;
+        }
+
+        const char* begin() const { return data(); }
+        const char* end() const { return data() + _length; }
+
+        /**
+         * @brief Gets part of the contents.
+         *
+         * @param position The first character of the part; must not exceed length().
+         * @param count The number of characters, or as many as there are.
+         * @return A view of the part.
+         */
+        StringView substr(std::size_t position, std::size_t count = StringView::npos) const
+        {
+            return view().substr(position, count);
+        }
+
+        /**
+         * @brief Finds the first occurrence of a character.
+         *
+         * @param ch The character to find.
+         * @param position The position to start searching at.
+         * @return The position of the character, or StringView::npos.
+         */
+        std::size_t find(char ch, std::size_t position = 0) const
+        {
+            return view().find(ch, position);
+        }
+
+        /**
+         * @brief Finds the first occurrence of a substring.
+         *
+         * @param needle The substring to find.
+         * @param position The position to start searching at.
+         * @return The position of the substring, or StringView::npos.
+         */
+        std::size_t find(StringView needle, std::size_t position = 0) const
+        {
+            return view().find(needle, position);
+        }
+
+        /**
+         * @brief Finds the last occurrence of a character.
+         *
+         * @param ch The character to find.
+         * @param position The last position a match may start at.
+         * @return The position of the character, or StringView::npos.
+         */
+        std::size_t rfind(char ch, std::size_t position = StringView::npos) const
+        {
+            return view().rfind(ch, position);
+        }
+
+        /**
+         * @brief Finds the last occurrence of a substring.
+         *
+         * @param needle The substring to find.
+         * @param position The last position a match may start at.
+         * @return The position of the substring, or StringView::npos.
+         */
+        std::size_t rfind(StringView needle, std::size_t position = StringView::npos) const
+        {
+            return view().rfind(needle, position);
+        }
+
+        /**
+         * @brief Finds the first character that belongs to a set.
+         *
+         * @param set The characters to look for.
+         * @param position The position to start searching at.
+         * @return The position of the character, or StringView::npos.
+         */
+        std::size_t find_first_of(StringView set, std::size_t position = 0) const
+        {
+            return view().find_first_of(set, position);
+        }
+
+        /**
+         * @brief Counts the occurrences of a character.
+         *
+         * @param ch The character to count.
+         * @return The number of occurrences.
+         */
+        std::size_t count(char ch) const
+        {
+            return view().count(ch);
+        }
+
+        /**
+         * @brief Hashes the contents (the same hash as a String or StringView with equal characters).
+         *
+         * @return The hash.
+         */
+        std::size_t hash() const
+        {
+            return view().hash();
+        }
+
+        /**
+         * @brief Checks whether the contents start with a prefix.
+         *
+         * @param prefix The prefix.
+         * @return true if the contents start with the prefix, false otherwise.
+         */
+        bool starts_with(StringView prefix) const
+        {
+            return view().starts_with(prefix);
+        }
+
+        /**
+         * @brief Checks whether the contents end with a suffix.
+         *
+         * @param suffix The suffix.
+         * @return true if the contents end with the suffix, false otherwise.
+         */
+        bool ends_with(StringView suffix) const
+        {
+            return view().ends_with(suffix);
+        }
+
+        // #endregion
+
+    private:
+        /**
+         * @brief Closes a descriptor after a failure without losing the errno of the failure.
+         */
+        static void _closePreservingErrno(int fileDescriptor)
+        {
+            int savedErrno = errno;
+            ::close(fileDescriptor);
+            errno = savedErrno;
+        }
+
+        /**
+         * @brief Unmaps the file, if any.
+         */
+        void _unmap()
+        {
+            if (_mapping)
+            {
+                ::munmap(_mapping, _length);
+            }
+            _mapping = nullptr;
+            _length = 0;
+            _isOpen = false;
+        }
+
+        void* _mapping;         ///< The start of the mapping, or nullptr (not open, or an empty file).
+        std::size_t _length;    ///< The length of the mapping.
+        bool _isOpen;           ///< Whether open() succeeded.
+    };
+}
+
+#endif // MAPPED_STRING_HPP
@@ -0,0 +1,313 @@
+/**************************************************************************************************
+ * @file MemoryResource.hpp
+ *
+ * @brief Polymorphic memory resources for allocator-aware strings.
+ *
+ * This file contains a small, C++14 counterpart of std::pmr::memory_resource: an
+ * abstract MemoryResource interface, the default new/delete resource, and a
+ * MonotonicArena that bump-allocates from large blocks and frees them all at once.
+ *
+ **************************************************************************************************/
+
+#ifndef MEMORY_RESOURCE_HPP
+#define MEMORY_RESOURCE_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace UserDefined
+{
+    /**
+     * @class MemoryResource
+     * @brief An abstract source of memory, selected at run time.
+     *
+     * Mirrors std::pmr::memory_resource: the public non-virtual functions forward to
+     * the protected virtual ones that derived resources implement.
+     */
+    class MemoryResource
+    {
+    public:
+        virtual ~MemoryResource() {}
+
+        /**
+         * @brief Allocates memory.
+         *
+         * @param bytes The number of bytes to allocate.
+         * @param alignment The required alignment (a power of two).
+         * @return The allocated memory.
+         */
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            return doAllocate(bytes, alignment);
+        }
+
+        /**
+         * @brief Returns memory obtained from allocate() with the same size and alignment.
+         *
+         * @param memory The memory to return.
+         * @param bytes The size passed to allocate().
+         * @param alignment The alignment passed to allocate().
+         */
+        void deallocate(void* memory, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            doDeallocate(memory, bytes, alignment);
+        }
+
+        /**
+         * @brief Checks whether memory allocated from one resource can be freed by the other.
+         *
+         * @param otherResource The resource to compare to.
+         * @return true if the resources are interchangeable, false otherwise.
+         */
+        bool isEqual(const MemoryResource& otherResource) const noexcept
+        {
+            return this == &otherResource || doIsEqual(otherResource);
+        }
+
+    protected:
+        virtual void* doAllocate(std::size_t bytes, std::size_t alignment) = 0;
+        virtual void doDeallocate(void* memory, std::size_t bytes, std::size_t alignment) = 0;
+        virtual bool doIsEqual(const MemoryResource& otherResource) const noexcept = 0;
+    };
+
+    /**
+     * @class NewDeleteResource
+     * @brief The default resource, allocating with new char[] and freeing with delete[].
+     */
+    class NewDeleteResource : public MemoryResource
+    {
+    protected:
+        void* doAllocate(std::size_t bytes, std::size_t alignment) override
+        {
+            assert(alignment <= alignof(std::max_align_t));
+            (void)alignment;
+            return new char[bytes];
+        }
+
+        void doDeallocate(void* memory, std::size_t, std::size_t) override
+        {
+            delete[] static_cast<char*>(memory);
+        }
+
+        bool doIsEqual(const MemoryResource& otherResource) const noexcept override
+        {
+            return dynamic_cast<const NewDeleteResource*>(&otherResource) != nullptr;
+        }
+    };
+
+    /**
+     * @brief Gets the process-wide new/delete resource.
+     *
+     * @return The new/delete resource.
+     */
+    inline MemoryResource* newDeleteResource() noexcept
+    {
+        static NewDeleteResource resource;
+        return &resource;
+    }
+
+    namespace Detail
+    {
+        inline std::atomic<MemoryResource*>& defaultResourceSlot() noexcept
+        {
+            static std::atomic<MemoryResource*> slot(newDeleteResource());
+            return slot;
+        }
+    }
+
+    /**
+     * @brief Gets the resource used by objects constructed without an explicit resource.
+     *
+     * @return The default resource (initially the new/delete resource).
+     */
+    inline MemoryResource* defaultResource() noexcept
+    {
+        return Detail::defaultResourceSlot().load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Replaces the default resource.
+     *
+     * @param resource The new default resource, or nullptr for the new/delete resource.
+     * @return The previous default resource.
+     */
+    inline MemoryResource* setDefaultResource(MemoryResource* resource) noexcept
+    {
+        return Detail::defaultResourceSlot().exchange(resource ? resource : newDeleteResource(), std::memory_order_acq_rel);
+    }
+
+    /**
+     * @class MonotonicArena
+     * @brief A bump allocator that frees everything at once.
+     *
+     * Memory comes from blocks obtained from an upstream resource; each new block is twice
+     * the size of the previous one. deallocate() does nothing, and release() (or the
+     * destructor) hands all blocks back to the upstream resource. An optional initial
+     * buffer, e.g. on the stack, is used before any block is allocated.
+     *
+     * A typical use is one arena per request: every String of the request allocates from
+     * it without touching the global heap, and the whole request is freed in one shot.
+     * The arena is not thread safe; give each thread its own arena.
+     */
+    class MonotonicArena : public MemoryResource
+    {
+    public:
+
+        // #region Constructors/Destruction
+
+        /**
+         * @brief Constructs an arena that allocates its first block on demand.
+         *
+         * @param initialBlockSize The size of the first block.
+         * @param upstream The resource the blocks are allocated from.
+         */
+        explicit MonotonicArena(std::size_t initialBlockSize = 1024, MemoryResource* upstream = newDeleteResource())
+            : _upstream(upstream)
+            , _blocks(nullptr)
+            , _initialBuffer(nullptr)
+            , _initialBufferSize(0)
+            , _cursor(nullptr)
+            , _remaining(0)
+            , _initialBlockSize(initialBlockSize)
+        {
+            if (_initialBlockSize < _minimumBlockSize)
+            {
+                _initialBlockSize = _minimumBlockSize;
+            }
+            _nextBlockSize = _initialBlockSize;
+        }
+
+        /**
+         * @brief Constructs an arena that first allocates from a caller-provided buffer.
+         *
+         * @param initialBuffer The buffer to allocate from first; it must outlive the arena.
+         * @param bufferSize The size of the buffer.
+         * @param upstream The resource further blocks are allocated from.
+         */
+        MonotonicArena(void* initialBuffer, std::size_t bufferSize, MemoryResource* upstream = newDeleteResource())
+            : MonotonicArena(2 * bufferSize, upstream)
+        {
+            _initialBuffer = static_cast<char*>(initialBuffer);
+            _initialBufferSize = bufferSize;
+            _cursor = _initialBuffer;
+            _remaining = bufferSize;
+        }
+
+        MonotonicArena(const MonotonicArena&) = delete;
+        MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+        /**
+         * @brief Destroy the MonotonicArena object, releasing all its blocks.
+         */
+        ~MonotonicArena() override
+        {
+            release();
+        }
+
+        // #endregion
+
+        // #region Public Methods
+
+        /**
+         * @brief Frees every block at once. All memory handed out by the arena becomes invalid.
+         *
+         * The initial buffer, if any, is reused for the next allocations, and block sizes
+         * start over from the initial block size.
+         */
+        void release() noexcept
+        {
+            while (_blocks)
+            {
+                BlockHeader* next = _blocks->next;
+                _upstream->deallocate(_blocks, _blocks->size, alignof(std::max_align_t));
+                _blocks = next;
+            }
+
+            _cursor = _initialBuffer;
+            _remaining = _initialBufferSize;
+            _nextBlockSize = _initialBlockSize;
+        }
+
+        /**
+         * @brief Gets the resource the blocks are allocated from.
+         *
+         * @return The upstream resource.
+         */
+        MemoryResource* upstreamResource() const
+        {
+            return _upstream;
+        }
+
+        // #endregion
+
+    protected:
+        void* doAllocate(std::size_t bytes, std::size_t alignment) override
+        {
+            std::size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(_cursor) % alignment) % alignment;
+
+            if (!_cursor || padding + bytes > _remaining)
+            {
+                _allocateBlock(bytes + alignment);
+                padding = (alignment - reinterpret_cast<std::uintptr_t>(_cursor) % alignment) % alignment;
+            }
+
+            void* memory = _cursor + padding;
+            _cursor += padding + bytes;
+            _remaining -= padding + bytes;
+            return memory;
+        }
+
+        void doDeallocate(void*, std::size_t, std::size_t) override
+        {
+        }
+
+        bool doIsEqual(const MemoryResource&) const noexcept override
+        {
+            return false;
+        }
+
+    private:
+        static constexpr std::size_t _minimumBlockSize = 64;    ///< The smallest block requested from upstream.
+
+        /**
+         * @struct BlockHeader
+         * @brief Placed at the start of every upstream block to chain the blocks together.
+         */
+        struct alignas(std::max_align_t) BlockHeader
+        {
+            BlockHeader* next;      ///< The previously allocated block.
+            std::size_t size;       ///< The size of this block, header included.
+        };
+
+        /**
+         * @brief Starts a new block large enough for the given number of bytes.
+         *
+         * @param bytes The number of bytes the block must be able to hand out.
+         */
+        void _allocateBlock(std::size_t bytes)
+        {
+            std::size_t blockSize = sizeof(BlockHeader) + (bytes > _nextBlockSize ? bytes : _nextBlockSize);
+            auto block = static_cast<BlockHeader*>(_upstream->allocate(blockSize, alignof(std::max_align_t)));
+            block->next = _blocks;
+            block->size = blockSize;
+
+            _blocks = block;
+            _cursor = reinterpret_cast<char*>(block + 1);
+            _remaining = blockSize - sizeof(BlockHeader);
+            _nextBlockSize *= 2;
+        }
+
+        MemoryResource* _upstream;          ///< The resource the blocks are allocated from.
+        BlockHeader* _blocks;               ///< The most recent block; older blocks are chained behind it.
+        char* _initialBuffer;               ///< The caller-provided buffer, if any.
+        std::size_t _initialBufferSize;     ///< The size of the caller-provided buffer.
+        char* _cursor;                      ///< The next free byte.
+        std::size_t _remaining;             ///< The number of free bytes after the cursor.
+        std::size_t _initialBlockSize;      ///< The size of the first block.
+        std::size_t _nextBlockSize;         ///< The size of the next block (doubles every time).
+    };
+}
+
+#endif // MEMORY_RESOURCE_HPP
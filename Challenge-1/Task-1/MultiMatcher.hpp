@@ -0,0 +1,306 @@
+/**************************************************************************************************
+ * @file MultiMatcher.hpp
+ *
+ * @brief Finds many patterns in one pass over a string.
+ *
+ * This file contains the definition of MultiMatcher, an Aho-Corasick automaton
+ * compiled into a dense transition table. Scanning a text costs one table lookup
+ * per character no matter how many patterns there are, and reports every
+ * occurrence of every pattern, overlapping ones included.
+ *
+ **************************************************************************************************/
+
+#ifndef MULTI_MATCHER_HPP
+#define MULTI_MATCHER_HPP
+
+#include "StringView.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace UserDefined
+{
+    /**
+     * @class MultiMatcher
+     * @brief A compiled set of patterns that can be searched for all at once.
+     *
+     * Characters that appear in no pattern share one column of the transition table,
+     * so the table has (number of states) x (distinct pattern characters + 1) entries
+     * and stays small enough to live in cache for a few hundred keywords. Every entry
+     * is a complete transition (failure links are folded in when the matcher is built),
+     * so the scan loop has no inner loop and no branch other than "is this a match".
+     *
+     * A matcher is immutable once built; one instance may be shared by any number of
+     * threads scanning concurrently.
+     */
+    class MultiMatcher
+    {
+    public:
+        /**
+         * @struct Match
+         * @brief One occurrence of a pattern in a text.
+         */
+        struct Match
+        {
+            std::size_t pattern;    ///< The index of the pattern, in the order the patterns were given.
+            std::size_t position;   ///< The position of the first character of the occurrence.
+            std::size_t length;     ///< The length of the pattern.
+
+            bool operator==(const Match& compareMatch) const
+            {
+                return pattern == compareMatch.pattern && position == compareMatch.position && length == compareMatch.length;
+            }
+        };
+
+        // #region Constructors
+
+        /**
+         * @brief Compiles a set of patterns.
+         *
+         * @param patterns The non-empty patterns to search for; they are not referenced after construction.
+         */
+        explicit MultiMatcher(const std::vector<StringView>& patterns)
+        {
+            _build(patterns);
+        }
+
+        /**
+         * @brief Compiles a set of patterns.
+         *
+         * @param patterns The non-empty patterns to search for.
+         */
+        MultiMatcher(std::initializer_list<StringView> patterns)
+        {
+            _build(std::vector<StringView>(patterns));
+        }
+
+        // #endregion
+
+        // #region Public Methods
+
+        /**
+         * @brief Gets the number of patterns.
+         *
+         * @return The number of patterns the matcher was built with.
+         */
+        std::size_t patternCount() const
+        {
+            return _patternLengths.size();
+        }
+
+        /**
+         * @brief Gets the number of states of the automaton.
+         *
+         * @return The number of states (rows of the transition table).
+         */
+        std::size_t stateCount() const
+        {
+            return _table.size() / _classCount;
+        }
+
+        /**
+         * @brief Reports every occurrence of every pattern in one pass over a text.
+         *
+         * Matches are reported in the order in which they end; matches ending at the same
+         * character are reported longest first.
+         *
+         * @param text The text to scan (a String, C-string or view).
+         * @param onMatch Called with each Match.
+         */
+        template <typename Callback>
+        void scan(StringView text, Callback onMatch) const
+        {
+            const std::uint32_t* table = _table.data();
+            const std::uint8_t* classes = _classes;
+            std::uint32_t entry = 0;
+
+            for (std::size_t i = 0; i < text.length(); ++i)
+            {
+                entry = table[(entry >> 1) + classes[static_cast<unsigned char>(text[i])]];
+                if (entry & 1)
+                {
+                    _report(entry >> 1, i + 1, onMatch);
+                }
+            }
+        }
+
+        /**
+         * @brief Collects every occurrence of every pattern.
+         *
+         * @param text The text to scan.
+         * @return The matches, in the order described for scan().
+         */
+        std::vector<Match> findAll(StringView text) const
+        {
+            std::vector<Match> matches;
+            scan(text, [&matches](const Match& match) { matches.push_back(match); });
+            return matches;
+        }
+
+        /**
+         * @brief Checks whether any pattern occurs in a text, stopping at the first match.
+         *
+         * @param text The text to scan.
+         * @return true if at least one pattern occurs in the text, false otherwise.
+         */
+        bool containsAny(StringView text) const
+        {
+            const std::uint32_t* table = _table.data();
+            std::uint32_t entry = 0;
+
+            for (std::size_t i = 0; i < text.length(); ++i)
+            {
+                entry = table[(entry >> 1) + _classes[static_cast<unsigned char>(text[i])]];
+                if (entry & 1)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // #endregion
+
+    private:
+        static constexpr std::uint32_t _noState = static_cast<std::uint32_t>(-1);     ///< Marks a missing link.
+
+        /**
+         * @brief Builds the character classes, the trie, the failure links and the dense table.
+         */
+        void _build(const std::vector<StringView>& patterns)
+        {
+            // Characters used by some pattern get their own column; all others share column 0.
+            for (std::size_t c = 0; c < 256; ++c)
+            {
+                _classes[c] = 0;
+            }
+            _classCount = 1;
+            for (StringView pattern : patterns)
+            {
+                assert(!pattern.empty());
+                for (char ch : pattern)
+                {
+                    std::uint8_t& characterClass = _classes[static_cast<unsigned char>(ch)];
+                    if (characterClass == 0)
+                    {
+                        characterClass = static_cast<std::uint8_t>(_classCount++);
+                    }
+                }
+            }
+            // 256 used characters would overflow the 8-bit class; they then simply have no shared column.
+            if (_classCount > 256)
+            {
+                _classCount = 256;
+                for (std::size_t c = 0; c < 256; ++c)
+                {
+                    _classes[c] = static_cast<std::uint8_t>(c);
+                }
+            }
+
+            // The trie, in a dense table where 0 means "no edge" (nothing points back to the root).
+            std::vector<std::uint32_t> next(_classCount, 0);
+            std::vector<std::vector<std::uint32_t>> ownPatterns(1);
+            for (std::size_t p = 0; p < patterns.size(); ++p)
+            {
+                std::uint32_t state = 0;
+                for (char ch : patterns[p])
+                {
+                    std::uint32_t& edge = next[state * _classCount + _classes[static_cast<unsigned char>(ch)]];
+                    if (edge == 0)
+                    {
+                        edge = static_cast<std::uint32_t>(ownPatterns.size());
+                        ownPatterns.emplace_back();
+                        next.resize(next.size() + _classCount, 0);
+                    }
+                    state = next[state * _classCount + _classes[static_cast<unsigned char>(ch)]];
+                }
+                ownPatterns[state].push_back(static_cast<std::uint32_t>(p));
+                _patternLengths.push_back(patterns[p].length());
+            }
+
+            // Breadth-first: failure links, dictionary links, and completion of the transitions.
+            std::size_t stateTotal = ownPatterns.size();
+            std::vector<std::uint32_t> failure(stateTotal, 0);
+            _dictionaryLinks.assign(stateTotal, static_cast<std::uint32_t>(_noState));
+            std::vector<bool> reportable(stateTotal, false);
+            std::vector<std::uint32_t> queue;
+            queue.reserve(stateTotal);
+
+            for (std::size_t c = 0; c < _classCount; ++c)
+            {
+                if (next[c] != 0)
+                {
+                    queue.push_back(next[c]);
+                }
+            }
+            for (std::size_t head = 0; head < queue.size(); ++head)
+            {
+                std::uint32_t state = queue[head];
+                std::uint32_t fallback = failure[state];
+                _dictionaryLinks[state] = ownPatterns[fallback].empty() ? _dictionaryLinks[fallback] : fallback;
+                reportable[state] = !ownPatterns[state].empty() || _dictionaryLinks[state] != _noState;
+
+                for (std::size_t c = 0; c < _classCount; ++c)
+                {
+                    std::uint32_t& edge = next[state * _classCount + c];
+                    if (edge != 0)
+                    {
+                        failure[edge] = next[fallback * _classCount + c];
+                        queue.push_back(edge);
+                    }
+                    else
+                    {
+                        edge = next[fallback * _classCount + c];
+                    }
+                }
+            }
+
+            // Entries hold the offset of the target row, shifted left, with the low bit set if it reports matches.
+            assert(next.size() < (std::size_t(1) << 31));
+            _table.resize(next.size());
+            for (std::size_t i = 0; i < next.size(); ++i)
+            {
+                _table[i] = ((next[i] * static_cast<std::uint32_t>(_classCount)) << 1) | (reportable[next[i]] ? 1u : 0u);
+            }
+
+            _outputStarts.assign(1, 0);
+            for (const auto& stateOutputs : ownPatterns)
+            {
+                _outputs.insert(_outputs.end(), stateOutputs.begin(), stateOutputs.end());
+                _outputStarts.push_back(static_cast<std::uint32_t>(_outputs.size()));
+            }
+        }
+
+        /**
+         * @brief Reports the patterns recognized by a state, following its dictionary links.
+         *
+         * @param row The offset of the state's row in the table.
+         * @param end The position just past the last matched character.
+         * @param onMatch The callback to report to.
+         */
+        template <typename Callback>
+        void _report(std::uint32_t row, std::size_t end, Callback& onMatch) const
+        {
+            for (std::uint32_t state = row / static_cast<std::uint32_t>(_classCount); state != _noState; state = _dictionaryLinks[state])
+            {
+                for (std::uint32_t o = _outputStarts[state]; o < _outputStarts[state + 1]; ++o)
+                {
+                    std::size_t length = _patternLengths[_outputs[o]];
+                    onMatch(Match{ _outputs[o], end - length, length });
+                }
+            }
+        }
+
+        std::uint8_t _classes[256];                 ///< The column of every character.
+        std::size_t _classCount;                    ///< The number of columns of the table.
+        std::vector<std::uint32_t> _table;          ///< The transitions, one row per state (see _build()).
+        std::vector<std::uint32_t> _dictionaryLinks;    ///< The nearest state on the failure chain that ends a pattern.
+        std::vector<std::uint32_t> _outputStarts;   ///< Where the patterns of each state start in _outputs.
+        std::vector<std::uint32_t> _outputs;        ///< The patterns ending at each state, grouped by state.
+        std::vector<std::size_t> _patternLengths;   ///< The length of each pattern.
+    };
+}
+
+#endif // MULTI_MATCHER_HPP
@@ -0,0 +1,548 @@
+/**************************************************************************************************
+ * @file Rope.hpp
+ *
+ * @brief A rope (cord) string for large, frequently edited texts.
+ *
+ * This file contains the definition of a rope: a balanced binary tree whose
+ * leaves refer to ranges of immutable, shared String chunks. Concatenation,
+ * substring, insertion and erasure rebuild only one path of the tree and
+ * never copy the characters of the chunks.
+ *
+ **************************************************************************************************/
+
+#ifndef ROPE_HPP
+#define ROPE_HPP
+
+#include "String.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace UserDefined
+{
+    /**
+     * @class Rope
+     * @brief A string stored as a balanced tree of shared String chunks.
+     *
+     * The tree is an AVL tree with the characters in its leaves. Nodes are
+     * immutable and shared between ropes, so copying a rope is O(1) and
+     * concat(), substr(), insert() and erase() run in O(log n) time.
+     * Like String, a Rope is not thread safe, but separate ropes sharing
+     * chunks can be used from different threads.
+     */
+    class Rope
+    {
+    private:
+        struct Node;
+        using NodePointer = std::shared_ptr<const Node>;
+
+    public:
+        /**
+         * @class ChunkIterator
+         * @brief Iterates over the chunks of a rope, in order, without copying them.
+         */
+        class ChunkIterator
+        {
+        public:
+            /**
+             * @brief Constructs an iterator positioned on the first chunk of a tree.
+             *
+             * @param root The root of the tree, or nullptr for the end iterator.
+             */
+            explicit ChunkIterator(const Node* root)
+            {
+                _descendLeft(root);
+            }
+
+            /**
+             * @brief Gets the current chunk.
+             *
+             * @return The characters of the current chunk.
+             */
+            StringPiece operator*() const
+            {
+                const Node* leaf = _path.back();
+                return StringPiece(leaf->chunk->c_str() + leaf->offset, leaf->length);
+            }
+
+            /**
+             * @brief Advances to the next chunk.
+             *
+             * @return A reference to the iterator.
+             */
+            ChunkIterator& operator++()
+            {
+                _path.pop_back();
+                if (!_path.empty())
+                {
+                    const Node* parent = _path.back();
+                    _path.pop_back();
+                    _descendLeft(parent->right.get());
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Comparison operator.
+             *
+             * @param other The iterator to compare to.
+             * @return true if both iterators are on the same chunk, false otherwise.
+             */
+            bool operator==(const ChunkIterator& other) const
+            {
+                return _path == other._path;
+            }
+
+            /**
+             * @brief Comparison operator.
+             *
+             * @param other The iterator to compare to.
+             * @return true if the iterators are on different chunks, false otherwise.
+             */
+            bool operator!=(const ChunkIterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            /**
+             * @brief Pushes the left spine of a subtree, ending on its first leaf.
+             *
+             * Internal nodes stay on the path so that their right subtree can be visited later.
+             *
+             * @param node The root of the subtree.
+             */
+            void _descendLeft(const Node* node)
+            {
+                while (node)
+                {
+                    _path.push_back(node);
+                    node = node->left.get();
+                }
+            }
+
+            std::vector<const Node*> _path;     ///< Internal nodes still to visit, then the current leaf.
+        };
+
+        /**
+         * @class ChunkRange
+         * @brief A range over the chunks of a rope, usable in a range-based for loop.
+         */
+        class ChunkRange
+        {
+        public:
+            /**
+             * @brief Constructs the range.
+             *
+             * @param root The root of the tree to iterate over.
+             */
+            explicit ChunkRange(const Node* root)
+                : _root(root)
+            {
+            }
+
+            ChunkIterator begin() const { return ChunkIterator(_root); }
+            ChunkIterator end() const { return ChunkIterator(nullptr); }
+
+        private:
+            const Node* _root;      ///< The root of the tree to iterate over.
+        };
+
+        // #region Constructors/Destruction
+
+        /**
+         * @brief Default constructor.
+         *
+         * Constructs an empty rope.
+         */
+        Rope() = default;
+
+        /**
+         * @brief Parameterized constructor.
+         *
+         * Constructs a rope holding a copy of a string.
+         *
+         * @param inputString The string to copy.
+         */
+        Rope(const String& inputString)
+            : Rope(String(inputString))
+        {
+        }
+
+        /**
+         * @brief Parameterized constructor.
+         *
+         * Constructs a rope that takes over a string; its characters are not copied.
+         *
+         * @param inputString The string to take over.
+         */
+        Rope(String&& inputString)
+            : _root(_makeLeaf(std::make_shared<const String>(std::move(inputString))))
+        {
+        }
+
+        /**
+         * @brief Parameterized constructor.
+         *
+         * Constructs a rope from a C-string.
+         *
+         * @param inputString The C-string to construct from.
+         */
+        Rope(const char* inputString)
+            : Rope(String(inputString))
+        {
+        }
+
+        // #endregion
+
+        // #region Public Methods
+
+        /**
+         * @brief Gets the length of the rope.
+         *
+         * @return The number of characters in the rope.
+         */
+        std::size_t length() const
+        {
+            return _root ? _root->length : 0;
+        }
+
+        /**
+         * @brief Gets the character at the given position in O(log n) time.
+         *
+         * @param position The position of the character; must be less than length().
+         * @return The character.
+         */
+        char at(std::size_t position) const
+        {
+            const Node* node = _root.get();
+            while (node->left)
+            {
+                if (position < node->left->length)
+                {
+                    node = node->left.get();
+                }
+                else
+                {
+                    position -= node->left->length;
+                    node = node->right.get();
+                }
+            }
+            return node->chunk->c_str()[node->offset + position];
+        }
+
+        /**
+         * @brief Appends another rope to the end of this rope in O(log n) time.
+         *
+         * @param appendRope The rope to append.
+         * @return A reference to the rope.
+         */
+        Rope& append(const Rope& appendRope)
+        {
+            _root = _join(_root, appendRope._root);
+            return *this;
+        }
+
+        /**
+         * @brief Compound append operator.
+         *
+         * @param appendRope The rope to append.
+         * @return A reference to the rope.
+         */
+        Rope& operator+=(const Rope& appendRope)
+        {
+            return append(appendRope);
+        }
+
+        /**
+         * @brief Gets part of the rope in O(log n) time. The chunks are shared, not copied.
+         *
+         * @param position The position of the first character; must not exceed length().
+         * @param count The maximum number of characters.
+         * @return A rope holding the requested characters.
+         */
+        Rope substr(std::size_t position, std::size_t count) const
+        {
+            NodePointer tail = _split(_root, position).second;
+            count = std::min(count, length() - position);
+
+            return Rope(_split(tail, count).first);
+        }
+
+        /**
+         * @brief Inserts another rope at the given position in O(log n) time.
+         *
+         * @param position The position to insert at; must not exceed length().
+         * @param insertRope The rope to insert.
+         * @return A reference to the rope.
+         */
+        Rope& insert(std::size_t position, const Rope& insertRope)
+        {
+            auto parts = _split(_root, position);
+            _root = _join(_join(parts.first, insertRope._root), parts.second);
+            return *this;
+        }
+
+        /**
+         * @brief Erases characters from the rope in O(log n) time.
+         *
+         * @param position The position of the first character to erase; must not exceed length().
+         * @param count The maximum number of characters to erase.
+         * @return A reference to the rope.
+         */
+        Rope& erase(std::size_t position, std::size_t count)
+        {
+            auto parts = _split(_root, position);
+            count = std::min(count, length() - position);
+            _root = _join(parts.first, _split(parts.second, count).second);
+            return *this;
+        }
+
+        /**
+         * @brief Copies the whole rope into a single String.
+         *
+         * @return A String holding all the characters of the rope.
+         */
+        String flatten() const
+        {
+            String flatString;
+            flatString.reserve(length());
+            for (StringPiece chunk : chunks())
+            {
+                flatString.append(chunk.data(), chunk.length());
+            }
+            return flatString;
+        }
+
+        /**
+         * @brief Gets the chunks of the rope, in order, for zero-copy traversal.
+         *
+         * The range is invalidated by any modification of the rope.
+         *
+         * @return A range of StringPiece chunks.
+         */
+        ChunkRange chunks() const
+        {
+            return ChunkRange(_root.get());
+        }
+
+        // #endregion
+
+        /**
+         * @brief Inserts the rope into an output stream, chunk by chunk, without flattening it.
+         *
+         * @param outputStream The output stream.
+         * @param outputRope The rope to insert.
+         *
+         * @return The output stream.
+         */
+        friend std::ostream& operator<<(std::ostream& outputStream, const Rope& outputRope)
+        {
+            for (StringPiece chunk : outputRope.chunks())
+            {
+                outputStream.write(chunk.data(), static_cast<std::streamsize>(chunk.length()));
+            }
+            return outputStream;
+        }
+
+    private:
+        static constexpr std::size_t _mergeLimit = 128;    ///< Adjacent leaves shorter than this in total are merged.
+
+        /**
+         * @struct Node
+         * @brief A node of the tree: a leaf referring to a chunk range, or an internal node with two children.
+         */
+        struct Node
+        {
+            std::size_t length;                     ///< The number of characters under this node.
+            int height;                             ///< The height of the subtree (0 for leaves).
+            NodePointer left;                       ///< The left child (internal nodes only).
+            NodePointer right;                      ///< The right child (internal nodes only).
+            std::shared_ptr<const String> chunk;    ///< The shared chunk (leaves only).
+            std::size_t offset;                     ///< The position of the leaf's characters in the chunk.
+        };
+
+        /**
+         * @brief Constructs a rope from the root of a tree.
+         *
+         * @param root The root of the tree.
+         */
+        explicit Rope(NodePointer root)
+            : _root(std::move(root))
+        {
+        }
+
+        // #region Private Methods
+
+        static int _height(const NodePointer& node)
+        {
+            return node ? node->height : -1;
+        }
+
+        /**
+         * @brief Makes a leaf referring to part of a chunk.
+         *
+         * @param chunk The shared chunk.
+         * @param offset The position of the first character in the chunk.
+         * @param length The number of characters.
+         * @return The leaf, or nullptr if the range is empty.
+         */
+        static NodePointer _makeLeaf(std::shared_ptr<const String> chunk, std::size_t offset, std::size_t length)
+        {
+            if (length == 0)
+            {
+                return nullptr;
+            }
+            return std::make_shared<const Node>(Node{ length, 0, nullptr, nullptr, std::move(chunk), offset });
+        }
+
+        static NodePointer _makeLeaf(std::shared_ptr<const String> chunk)
+        {
+            std::size_t length = chunk->length();
+            return _makeLeaf(std::move(chunk), 0, length);
+        }
+
+        /**
+         * @brief Makes an internal node from two non-empty subtrees.
+         *
+         * @param left The left subtree.
+         * @param right The right subtree.
+         * @return The new node.
+         */
+        static NodePointer _makeNode(NodePointer left, NodePointer right)
+        {
+            std::size_t length = left->length + right->length;
+            int height = std::max(left->height, right->height) + 1;
+            return std::make_shared<const Node>(Node{ length, height, std::move(left), std::move(right), nullptr, 0 });
+        }
+
+        /**
+         * @brief Makes an internal node, rotating once (or twice) if the heights differ by two.
+         *
+         * @param left The left subtree.
+         * @param right The right subtree.
+         * @return The balanced subtree.
+         */
+        static NodePointer _balance(const NodePointer& left, const NodePointer& right)
+        {
+            if (left->height > right->height + 1)
+            {
+                if (_height(left->left) >= _height(left->right))
+                {
+                    return _makeNode(left->left, _makeNode(left->right, right));
+                }
+                return _makeNode(_makeNode(left->left, left->right->left), _makeNode(left->right->right, right));
+            }
+
+            if (right->height > left->height + 1)
+            {
+                if (_height(right->right) >= _height(right->left))
+                {
+                    return _makeNode(_makeNode(left, right->left), right->right);
+                }
+                return _makeNode(_makeNode(left, right->left->left), _makeNode(right->left->right, right->right));
+            }
+
+            return _makeNode(left, right);
+        }
+
+        /**
+         * @brief Concatenates two trees in O(|height difference|) time.
+         *
+         * The taller tree is descended along its inner spine until the heights match, then
+         * rebalanced on the way back up. Two short leaves are merged into a new chunk to keep
+         * byte-at-a-time edits from fragmenting the rope.
+         *
+         * @param left The left tree (may be empty).
+         * @param right The right tree (may be empty).
+         * @return The concatenated tree.
+         */
+        static NodePointer _join(const NodePointer& left, const NodePointer& right)
+        {
+            if (!left)
+            {
+                return right;
+            }
+            if (!right)
+            {
+                return left;
+            }
+
+            if (left->height > right->height + 1)
+            {
+                return _balance(left->left, _join(left->right, right));
+            }
+            if (right->height > left->height + 1)
+            {
+                return _balance(_join(left, right->left), right->right);
+            }
+
+            if (left->height == 0 && right->height == 0 && left->length + right->length < _mergeLimit)
+            {
+                String merged;
+                merged.reserve(left->length + right->length);
+                merged.append(left->chunk->c_str() + left->offset, left->length);
+                merged.append(right->chunk->c_str() + right->offset, right->length);
+                return _makeLeaf(std::make_shared<const String>(std::move(merged)));
+            }
+
+            return _makeNode(left, right);
+        }
+
+        /**
+         * @brief Splits a tree into the characters before and after a position in O(log n) time.
+         *
+         * A leaf that straddles the position is split into two leaves sharing its chunk.
+         *
+         * @param node The tree to split (may be empty).
+         * @param position The split position; must not exceed the length of the tree.
+         * @return The trees holding [0, position) and [position, length).
+         */
+        static std::pair<NodePointer, NodePointer> _split(const NodePointer& node, std::size_t position)
+        {
+            if (!node || position == 0)
+            {
+                return { nullptr, node };
+            }
+            if (position >= node->length)
+            {
+                return { node, nullptr };
+            }
+
+            if (node->height == 0)
+            {
+                return { _makeLeaf(node->chunk, node->offset, position),
+                         _makeLeaf(node->chunk, node->offset + position, node->length - position) };
+            }
+
+            std::size_t leftLength = node->left->length;
+            if (position <= leftLength)
+            {
+                auto parts = _split(node->left, position);
+                return { parts.first, _join(parts.second, node->right) };
+            }
+
+            auto parts = _split(node->right, position - leftLength);
+            return { _join(node->left, parts.first), parts.second };
+        }
+
+        // #endregion
+
+        NodePointer _root;      ///< The root of the tree (nullptr for an empty rope).
+    };
+
+    /**
+     * @brief Addition (concatenation) operator.
+     *
+     * @param left The left rope.
+     * @param right The right rope.
+     * @return A rope holding the characters of both ropes, sharing their chunks.
+     */
+    inline Rope operator+(Rope left, const Rope& right)
+    {
+        return left.append(right);
+    }
+}
+
+#endif // ROPE_HPP
@@ -0,0 +1,400 @@
+/**************************************************************************************************
+ * @file Searcher.hpp
+ *
+ * @brief Substring search with a needle that is preprocessed once.
+ *
+ * This file contains the definition of Searcher, which analyses a needle when it
+ * is constructed and then finds it in any number of haystacks. Depending on the
+ * needle it searches with the vectorized first/last-character filter of Simd.hpp,
+ * with Boyer-Moore-Horspool, which skips up to a needle length per step, or with
+ * the Two-Way algorithm of Crochemore and Perrin, which runs in linear time and
+ * constant space whatever the input.
+ *
+ **************************************************************************************************/
+
+#ifndef SEARCHER_HPP
+#define SEARCHER_HPP
+
+#include "StringView.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace UserDefined
+{
+    /**
+     * @class Searcher
+     * @brief A needle compiled for repeated substring search.
+     *
+     * Every strategy runs in linear time in the worst case:
+     *  - the filter looks for a prefix of at most 32 characters with the vectorized
+     *    first/last-character kernel, which bounds its work per haystack position;
+     *  - both the filter and Horspool count the characters they compare to verify a
+     *    candidate and hand the rest of the haystack over to Two-Way as soon as that
+     *    work exceeds a constant per haystack character (as on repetitive inputs).
+     * With SSE2 or AVX2 the filter is the fastest choice except for long needles over a
+     * large alphabet, where Horspool's skips win; without vectors Horspool wins from
+     * about 9 characters. Two-Way itself is never the fastest on typical text.
+     *
+     * A searcher owns a copy of its needle, is immutable once built and may be shared
+     * by threads.
+     */
+    class Searcher
+    {
+    public:
+        /**
+         * @brief The search algorithms.
+         */
+        enum class Strategy
+        {
+            Filter,     ///< Vectorized first/last-character filter with a fallback to Two-Way on adversarial input.
+            Horspool,   ///< Boyer-Moore-Horspool with a fallback to Two-Way on adversarial input.
+            TwoWay      ///< Crochemore-Perrin Two-Way.
+        };
+
+        // #region Constructors
+
+        /**
+         * @brief Compiles a needle, choosing the strategy from its length and characters.
+         *
+         * @param needle The substring to search for (a String, C-string or view).
+         */
+        explicit Searcher(StringView needle)
+            : Searcher(needle, _chooseStrategy(needle))
+        {
+        }
+
+        /**
+         * @brief Compiles a needle for a given strategy (for tests and benchmarks).
+         *
+         * @param needle The substring to search for.
+         * @param strategy The algorithm to search with.
+         */
+        Searcher(StringView needle, Strategy strategy)
+            : _needle(needle.begin(), needle.end())
+            , _strategy(strategy)
+        {
+            _prepareTwoWay();
+            if (_strategy == Strategy::Horspool)
+            {
+                _prepareHorspool();
+            }
+        }
+
+        // #endregion
+
+        // #region Public Methods
+
+        /**
+         * @brief Gets the needle.
+         *
+         * @return A view of the searcher's copy of the needle.
+         */
+        StringView needle() const
+        {
+            return StringView(_needle.data(), _needle.size());
+        }
+
+        /**
+         * @brief Gets the strategy the searcher uses.
+         *
+         * @return The strategy.
+         */
+        Strategy strategy() const
+        {
+            return _strategy;
+        }
+
+        /**
+         * @brief Finds the first occurrence of the needle.
+         *
+         * @param haystack The text to search (a String, C-string or view).
+         * @param pos The position to start searching at.
+         * @return The position of the needle, or StringView::npos. An empty needle is found at pos if pos <= the haystack length.
+         */
+        std::size_t find(StringView haystack, std::size_t pos = 0) const
+        {
+            if (pos > haystack.length())
+            {
+                return StringView::npos;
+            }
+
+            const char* data = haystack.data() + pos;
+            std::size_t length = haystack.length() - pos;
+            std::size_t found;
+            if (_needle.size() <= 1 || _needle.size() > length)
+            {
+                found = Simd::findSubstring(data, length, _needle.data(), _needle.size());
+            }
+            else
+            {
+                switch (_strategy)
+                {
+                    case Strategy::Filter: found = _findFiltered(data, length); break;
+                    case Strategy::Horspool: found = _findHorspool(data, length); break;
+                    default: found = _findTwoWay(data, length, 0); break;
+                }
+            }
+            return found == Simd::notFound ? StringView::npos : pos + found;
+        }
+
+        // #endregion
+
+    private:
+        static constexpr std::size_t _filterMaxLength = 32;         ///< The longest needle prefix the filter looks for.
+        static constexpr std::size_t _workFactor = 4;               ///< Verification may compare this many characters per haystack character.
+        static constexpr std::size_t _scalarHorspoolLength = 9;     ///< Without vectors, Horspool is faster from this needle length.
+        static constexpr std::size_t _horspoolLength = 1024;        ///< With vectors, Horspool may be faster from this needle length...
+        static constexpr std::size_t _horspoolAlphabet = 128;       ///< ...if the needle has this many distinct characters.
+
+        /**
+         * @brief Picks the fastest strategy for a needle, as measured by BenchString.
+         *
+         * @param needle The needle.
+         * @return The strategy.
+         */
+        static Strategy _chooseStrategy(StringView needle)
+        {
+            if (Simd::activeLevel() == Simd::Level::Scalar)
+            {
+                return needle.length() >= _scalarHorspoolLength ? Strategy::Horspool : Strategy::Filter;
+            }
+            if (needle.length() < _horspoolLength)
+            {
+                return Strategy::Filter;
+            }
+
+            // Horspool only skips far when mismatching characters are unlikely to occur in the needle.
+            bool seen[256] = {};
+            std::size_t alphabet = 0;
+            for (char ch : needle)
+            {
+                if (!seen[static_cast<unsigned char>(ch)])
+                {
+                    seen[static_cast<unsigned char>(ch)] = true;
+                    alphabet++;
+                }
+            }
+            return alphabet >= _horspoolAlphabet ? Strategy::Horspool : Strategy::Filter;
+        }
+
+        /**
+         * @brief Finds the maximal suffix of the needle for an ordering of the characters.
+         *
+         * @param reversed Whether to use the reversed ordering.
+         * @param period Receives the period of the maximal suffix.
+         * @return The position where the maximal suffix starts.
+         */
+        std::size_t _maximalSuffix(bool reversed, std::size_t& period) const
+        {
+            const unsigned char* x = reinterpret_cast<const unsigned char*>(_needle.data());
+            std::size_t m = _needle.size();
+            std::size_t start = 0;      // The candidate suffix starts at start, and is compared with the one at candidate.
+            std::size_t candidate = 1;
+            std::size_t offset = 0;
+            period = 1;
+
+            while (candidate + offset < m)
+            {
+                unsigned char a = x[candidate + offset];
+                unsigned char b = x[start + offset];
+                if (reversed ? a > b : a < b)
+                {
+                    candidate += offset + 1;
+                    offset = 0;
+                    period = candidate - start;
+                }
+                else if (a == b)
+                {
+                    if (offset + 1 != period)
+                    {
+                        offset++;
+                    }
+                    else
+                    {
+                        candidate += period;
+                        offset = 0;
+                    }
+                }
+                else
+                {
+                    start = candidate;
+                    candidate = start + 1;
+                    offset = 0;
+                    period = 1;
+                }
+            }
+            return start;
+        }
+
+        /**
+         * @brief Computes the critical factorization of the needle and its period.
+         */
+        void _prepareTwoWay()
+        {
+            if (_needle.size() < 2)
+            {
+                _split = 0;
+                _period = 1;
+                _periodic = false;
+                return;
+            }
+
+            std::size_t period;
+            std::size_t reversedPeriod;
+            std::size_t split = _maximalSuffix(false, period);
+            std::size_t reversedSplit = _maximalSuffix(true, reversedPeriod);
+            if (reversedSplit > split)
+            {
+                split = reversedSplit;
+                period = reversedPeriod;
+            }
+
+            std::size_t m = _needle.size();
+            _split = split;
+            _periodic = split + period <= m && std::memcmp(_needle.data(), _needle.data() + period, split) == 0;
+            _period = _periodic ? period : (split > m - split ? split : m - split) + 1;
+        }
+
+        /**
+         * @brief Builds the bad-character shift table of Horspool.
+         */
+        void _prepareHorspool()
+        {
+            std::size_t m = _needle.size();
+            for (std::size_t c = 0; c < 256; ++c)
+            {
+                _shifts[c] = m;
+            }
+            for (std::size_t i = 0; i + 1 < m; ++i)
+            {
+                _shifts[static_cast<unsigned char>(_needle[i])] = m - 1 - i;
+            }
+        }
+
+        /**
+         * @brief Two-Way search of data[start, length). The caller guarantees 2 <= needle length <= length.
+         */
+        std::size_t _findTwoWay(const char* data, std::size_t length, std::size_t start) const
+        {
+            const char* x = _needle.data();
+            std::size_t m = _needle.size();
+            std::size_t memory = 0;     // In periodic mode, the length of the needle prefix known to match.
+
+            for (std::size_t j = start; j + m <= length;)
+            {
+                // Match the right part, left to right.
+                std::size_t i = _split > memory ? _split : memory;
+                while (i < m && x[i] == data[j + i])
+                {
+                    i++;
+                }
+                if (i < m)
+                {
+                    j += i - _split + 1;
+                    memory = 0;
+                    continue;
+                }
+
+                // Match the left part, right to left.
+                i = _split;
+                while (i > memory && x[i - 1] == data[j + i - 1])
+                {
+                    i--;
+                }
+                if (i <= memory)
+                {
+                    return j;
+                }
+
+                j += _period;
+                memory = _periodic ? m - _period : 0;
+            }
+            return Simd::notFound;
+        }
+
+        /**
+         * @brief Filtered search of data[0, length), switching to Two-Way when verifications pile up.
+         *
+         * The vectorized filter looks for a prefix of at most 32 characters, which bounds its own
+         * work per position; the rest of the needle is verified with memcmp and counted.
+         */
+        std::size_t _findFiltered(const char* data, std::size_t length) const
+        {
+            const char* x = _needle.data();
+            std::size_t m = _needle.size();
+            std::size_t prefixLength = m;
+            if (prefixLength > _filterMaxLength)
+            {
+                prefixLength = _filterMaxLength;
+            }
+            std::size_t compared = 0;
+
+            for (std::size_t j = 0; j + m <= length; ++j)
+            {
+                // Only prefixes followed by room for the rest of the needle are candidates.
+                std::size_t found = Simd::findSubstring(data + j, length - j - (m - prefixLength), x, prefixLength);
+                if (found == Simd::notFound)
+                {
+                    return Simd::notFound;
+                }
+                j += found;
+                if (prefixLength == m || std::memcmp(data + j + prefixLength, x + prefixLength, m - prefixLength) == 0)
+                {
+                    return j;
+                }
+                compared += m;
+                if (compared > _workFactor * (j + m))
+                {
+                    return _findTwoWay(data, length, j + 1);
+                }
+            }
+            return Simd::notFound;
+        }
+
+        /**
+         * @brief Horspool search of data[0, length), switching to Two-Way when comparisons pile up.
+         */
+        std::size_t _findHorspool(const char* data, std::size_t length) const
+        {
+            const char* x = _needle.data();
+            std::size_t m = _needle.size();
+            char lastCharacter = x[m - 1];
+            std::size_t compared = 0;
+
+            for (std::size_t j = 0; j + m <= length;)
+            {
+                char ch = data[j + m - 1];
+                if (ch == lastCharacter)
+                {
+                    std::size_t i = 0;
+                    while (i + 1 < m && data[j + i] == x[i])
+                    {
+                        i++;
+                    }
+                    if (i + 1 == m)
+                    {
+                        return j;
+                    }
+                    compared += i + 1;
+                    if (compared > _workFactor * (j + m))
+                    {
+                        return _findTwoWay(data, length, j);
+                    }
+                }
+                j += _shifts[static_cast<unsigned char>(ch)];
+            }
+            return Simd::notFound;
+        }
+
+        std::vector<char> _needle;      ///< The needle.
+        Strategy _strategy;             ///< The search algorithm.
+        std::size_t _split;             ///< Two-Way: the critical position, where the right part of the needle starts.
+        std::size_t _period;            ///< Two-Way: the shift after a match of the right part.
+        bool _periodic;                 ///< Two-Way: whether the shift is the period of the needle, remembering the matched prefix.
+        std::size_t _shifts[256];       ///< Horspool: the shift for each character under the last position of the window.
+    };
+}
+
+#endif // SEARCHER_HPP
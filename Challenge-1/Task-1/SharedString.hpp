@@ -0,0 +1,344 @@
+/**************************************************************************************************
+ * @file SharedString.hpp
+ *
+ * @brief An immutable, reference-counted string.
+ *
+ * This file contains the definition of SharedString, an immutable string whose
+ * copies share one String through an atomic reference count. It is meant for
+ * payloads handed to many consumers (cache elements, log lines, ...), possibly
+ * on different threads.
+ *
+ **************************************************************************************************/
+
+#ifndef SHARED_STRING_HPP
+#define SHARED_STRING_HPP
+
+#include "String.hpp"
+
+#include <atomic>
+#include <utility>
+
+namespace UserDefined
+{
+    /**
+     * @class SharedString
+     * @brief An immutable string with O(1), thread-safe copies.
+     *
+     * The characters live in a regular String, owned by a control block together
+     * with an atomic reference count. Copies only bump the count, so they are O(1)
+     * and never touch the characters. Because the String is never modified after
+     * construction, any number of threads may read and copy the same SharedString
+     * concurrently (a single SharedString object must still not be assigned while
+     * other threads read it, just like std::shared_ptr).
+     *
+     * Converting from a String rvalue moves the String into the control block, and
+     * toString() on a uniquely owned SharedString moves it back out, so a payload can
+     * round-trip without copying its characters.
+     */
+    class SharedString
+    {
+    public:
+
+        // #region Constructors/Destruction
+
+        /**
+         * @brief Default constructor.
+         *
+         * Constructs an empty string. No control block is allocated.
+         */
+        SharedString() noexcept
+            : _block(nullptr)
+        {
+        }
+
+        /**
+         * @brief Parameterized constructor.
+         *
+         * Constructs a shared string holding a copy of a string.
+         *
+         * @param inputString The string to copy.
+         */
+        SharedString(const String& inputString)
+            : _block(new ControlBlock(inputString))
+        {
+        }
+
+        /**
+         * @brief Parameterized constructor.
+         *
+         * Constructs a shared string that takes over a string; its characters are not copied.
+         *
+         * @param inputString The string to take over.
+         */
+        SharedString(String&& inputString)
+            : _block(new ControlBlock(std::move(inputString)))
+        {
+        }
+
+        /**
+         * @brief Parameterized constructor.
+         *
+         * Constructs a shared string from a C-string.
+         *
+         * @param inputString The C-string to construct from.
+         */
+        SharedString(const char* inputString)
+            : SharedString(String(inputString))
+        {
+        }
+
+        /**
+         * @brief Copy constructor.
+         *
+         * Shares the string of another shared string in O(1).
+         *
+         * @param sourceString The shared string to share.
+         */
+        SharedString(const SharedString& sourceString) noexcept
+            : _block(sourceString._block)
+        {
+            _acquire();
+        }
+
+        /**
+         * @brief Move constructor.
+         *
+         * Takes over the reference of another shared string and leaves it empty.
+         *
+         * @param sourceString The shared string to move.
+         */
+        SharedString(SharedString&& sourceString) noexcept
+            : _block(sourceString._block)
+        {
+            sourceString._block = nullptr;
+        }
+
+        /**
+         * @brief Destroy the SharedString object, freeing the string when the last reference goes away.
+         */
+        ~SharedString()
+        {
+            _releaseReference();
+        }
+
+        /**
+         * @brief Copy assignment operator.
+         *
+         * @param sourceString The shared string to share.
+         * @return A reference to the shared string.
+         */
+        SharedString& operator=(const SharedString& sourceString) noexcept
+        {
+            SharedString(sourceString).swap(*this);
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment operator.
+         *
+         * @param sourceString The shared string to move.
+         * @return A reference to the shared string.
+         */
+        SharedString& operator=(SharedString&& sourceString) noexcept
+        {
+            SharedString(std::move(sourceString)).swap(*this);
+            return *this;
+        }
+
+        // #endregion
+
+        // #region Overloaded Operators
+
+        /**
+         * @brief Comparison operator.
+         *
+         * Shared strings referring to the same control block are equal without comparing characters.
+         *
+         * @param compareString The shared string to compare to.
+         * @return true if the strings are equal, false otherwise.
+         */
+        bool operator==(const SharedString& compareString) const
+        {
+            return _block == compareString._block || str() == compareString.str();
+        }
+
+        // #endregion
+
+        // #region Public Methods
+
+        /**
+         * @brief Gets the shared String, giving read-only access to the whole String API.
+         *
+         * @return A reference to the shared String, valid as long as this object refers to it.
+         */
+        const String& str() const
+        {
+            return _block ? _block->value : _emptyString();
+        }
+
+        /**
+         * @brief Gets the length of the string.
+         *
+         * @return The length of the string.
+         */
+        std::size_t length() const
+        {
+            return str().length();
+        }
+
+        /**
+         * @brief Gets the string as a C-string.
+         *
+         * @return The string as a C-string.
+         */
+        const char* c_str() const
+        {
+            return str().c_str();
+        }
+
+        /**
+         * @brief Gets the number of SharedString objects sharing the string.
+         *
+         * @return The reference count (0 for a default-constructed shared string).
+         */
+        std::size_t useCount() const
+        {
+            return _block ? _block->references.load(std::memory_order_acquire) : 0;
+        }
+
+        /**
+         * @brief Checks whether this is the only reference to the string.
+         *
+         * @return true if no other SharedString shares the string, false otherwise.
+         */
+        bool unique() const
+        {
+            return useCount() <= 1;
+        }
+
+        /**
+         * @brief Copies the string into a mutable String.
+         *
+         * @return A String holding a copy of the characters.
+         */
+        String toString() const &
+        {
+            return str();
+        }
+
+        /**
+         * @brief Converts the shared string into a mutable String.
+         *
+         * When this is the only reference, the String is moved out of the control block
+         * and no characters are copied; otherwise the characters are copied. The shared
+         * string is left empty in both cases.
+         *
+         * @return A String holding the characters.
+         */
+        String toString() &&
+        {
+            SharedString owner(std::move(*this));
+
+            if (owner.unique())
+            {
+                return std::move(owner._block->value);
+            }
+            return owner.str();
+        }
+
+        /**
+         * @brief Exchanges the contents of two shared strings.
+         *
+         * @param otherString The shared string to swap with.
+         */
+        void swap(SharedString& otherString) noexcept
+        {
+            std::swap(_block, otherString._block);
+        }
+
+        // #endregion
+
+        /**
+         * @brief Inserts the string into an output stream.
+         *
+         * @param outputStream The output stream.
+         * @param outputString The string to insert.
+         *
+         * @return The output stream.
+         */
+        friend std::ostream& operator<<(std::ostream& outputStream, const SharedString& outputString)
+        {
+            return outputStream << outputString.str();
+        }
+
+    private:
+        /**
+         * @struct ControlBlock
+         * @brief The shared String and the number of SharedString objects referring to it.
+         */
+        struct ControlBlock
+        {
+            explicit ControlBlock(const String& inputValue)
+                : references(1)
+                , value(inputValue)
+            {
+            }
+
+            explicit ControlBlock(String&& inputValue)
+                : references(1)
+                , value(std::move(inputValue))
+            {
+            }
+
+            std::atomic<std::size_t> references;    ///< The number of SharedString objects referring to the block.
+            String value;                           ///< The shared string.
+        };
+
+        // #region Private Methods
+
+        /**
+         * @brief Gets the String returned for shared strings without a control block.
+         *
+         * @return A reference to a static empty String.
+         */
+        static const String& _emptyString()
+        {
+            static const String emptyString;
+            return emptyString;
+        }
+
+        /**
+         * @brief Adds a reference to the control block, if any.
+         *
+         * A relaxed increment is enough: the new reference is created from an existing one,
+         * which already keeps the block alive.
+         */
+        void _acquire() noexcept
+        {
+            if (_block)
+            {
+                _block->references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Drops the reference to the control block, deleting it with the last reference.
+         *
+         * The acquire-release decrement makes every other owner's reads happen before the deletion.
+         */
+        void _releaseReference() noexcept
+        {
+            if (_block && _block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                delete _block;
+            }
+            _block = nullptr;
+        }
+
+        // #endregion
+
+        ControlBlock* _block;   ///< The shared control block (nullptr for an empty string).
+    };
+}
+
+#endif // SHARED_STRING_HPP
@@ -0,0 +1,1116 @@
+/**************************************************************************************************
+ * @file Simd.hpp
+ *
+ * @brief Vectorized character search kernels used by String.
+ *
+ * This file contains SSE2 and AVX2 implementations of the low-level search
+ * primitives behind String::find(), rfind(), find_first_of(), count(),
+ * compare() and the ASCII case functions, plus portable scalar fallbacks. The
+ * instruction set is selected once at run time from what the CPU supports, so
+ * the code does not need to be compiled with -mavx2 and still runs on older x86
+ * processors and other architectures.
+ *
+ **************************************************************************************************/
+
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define USERDEFINED_SIMD_X86 1
+#include <immintrin.h>
+#define USERDEFINED_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define USERDEFINED_SIMD_X86 0
+#endif
+
+namespace UserDefined
+{
+    namespace Simd
+    {
+        /// Returned by the search kernels when nothing is found.
+        static constexpr std::size_t notFound = static_cast<std::size_t>(-1);
+
+        /**
+         * @brief The instruction sets the kernels can run with, from slowest to fastest.
+         */
+        enum class Level
+        {
+            Scalar,     ///< Portable C++ loops.
+            SSE2,       ///< 16-byte vectors (baseline on x86-64).
+            AVX2        ///< 32-byte vectors.
+        };
+
+        /**
+         * @brief Gets the fastest instruction set supported by the CPU.
+         *
+         * @return The best supported level.
+         */
+        inline Level supportedLevel()
+        {
+#if USERDEFINED_SIMD_X86
+            static const Level level = (__builtin_cpu_init(), __builtin_cpu_supports("avx2")) ? Level::AVX2 : Level::SSE2;
+            return level;
+#else
+            return Level::Scalar;
+#endif
+        }
+
+        namespace Detail
+        {
+            /**
+             * @brief The active level, or -1 until it is first read.
+             *
+             * The slot is constant-initialized, so reading it needs no initialization guard, which
+             * would otherwise add its cost (and a call on its slow path) to every inlined dispatch.
+             */
+            inline std::atomic<int>& activeLevelSlot()
+            {
+                static std::atomic<int> slot(-1);
+                return slot;
+            }
+
+            /**
+             * @brief Sets the active level to the supported one, unless setLevel() got there first.
+             */
+            __attribute__((noinline, cold)) inline Level initializeActiveLevel()
+            {
+                int level = -1;
+                Detail::activeLevelSlot().compare_exchange_strong(level, static_cast<int>(supportedLevel()), std::memory_order_relaxed);
+                return static_cast<Level>(Detail::activeLevelSlot().load(std::memory_order_relaxed));
+            }
+
+            inline unsigned countTrailingZeros(std::uint32_t mask) { return static_cast<unsigned>(__builtin_ctz(mask)); }
+            inline unsigned highestBit(std::uint32_t mask) { return 31u - static_cast<unsigned>(__builtin_clz(mask)); }
+            inline unsigned countTrailingZeros64(std::uint64_t mask) { return static_cast<unsigned>(__builtin_ctzll(mask)); }
+        }
+
+        /**
+         * @brief Gets the instruction set the kernels currently use.
+         *
+         * @return The active level (the supported level unless changed with setLevel()).
+         */
+        inline Level activeLevel()
+        {
+            int level = Detail::activeLevelSlot().load(std::memory_order_relaxed);
+            return level < 0 ? Detail::initializeActiveLevel() : static_cast<Level>(level);
+        }
+
+        /**
+         * @brief Selects the instruction set for the kernels, e.g. to test or benchmark the fallbacks.
+         *
+         * Levels the CPU does not support are lowered to the supported level.
+         *
+         * @param level The requested level.
+         * @return The level actually selected.
+         */
+        inline Level setLevel(Level level)
+        {
+            if (level > supportedLevel())
+            {
+                level = supportedLevel();
+            }
+            Detail::activeLevelSlot().store(static_cast<int>(level), std::memory_order_relaxed);
+            return level;
+        }
+
+        /**
+         * @class CharacterSet
+         * @brief The lookup tables of a set of characters, for findFirstOf().
+         *
+         * Building the tables costs a pass over the set; a CharacterSet built once can be
+         * searched for any number of times, e.g. once per token when splitting a string.
+         */
+        class CharacterSet
+        {
+        public:
+            /**
+             * @brief Builds the tables of a set of characters.
+             *
+             * @param set The characters of the set (duplicates are ignored).
+             * @param setLength The number of characters.
+             */
+            CharacterSet(const char* set, std::size_t setLength)
+                : _table()
+                , _nibbleTables()
+                , _size(0)
+            {
+                for (std::size_t s = 0; s < setLength; ++s)
+                {
+                    unsigned c = static_cast<unsigned char>(set[s]);
+                    if (!_table[c])
+                    {
+                        _table[c] = true;
+                        _characters[_size++] = set[s];
+                        // Bit (high nibble % 8) of the row for the low nibble, in the half selected by the sign bit.
+                        _nibbleTables[(c >= 128 ? 16 : 0) + (c & 0x0F)] |= static_cast<std::uint8_t>(1u << ((c >> 4) & 7));
+                    }
+                }
+            }
+
+            /// The number of distinct characters in the set.
+            std::size_t size() const { return _size; }
+            /// The distinct characters of the set.
+            const char* characters() const { return _characters; }
+            /// A membership flag for every character value.
+            const bool* table() const { return _table; }
+            /// The 32 nibble tables used by the AVX2 kernel.
+            const std::uint8_t* nibbleTables() const { return _nibbleTables; }
+
+        private:
+            bool _table[256];                   ///< Membership of every character value.
+            std::uint8_t _nibbleTables[32];     ///< Rows indexed by low nibble, for characters below and above 128.
+            char _characters[256];              ///< The distinct characters of the set.
+            std::size_t _size;                  ///< The number of distinct characters.
+        };
+
+        namespace Scalar
+        {
+            inline std::size_t findChar(const char* data, std::size_t length, char ch)
+            {
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    if (data[i] == ch)
+                    {
+                        return i;
+                    }
+                }
+                return notFound;
+            }
+
+            inline std::size_t findLastChar(const char* data, std::size_t length, char ch)
+            {
+                for (std::size_t i = length; i > 0; --i)
+                {
+                    if (data[i - 1] == ch)
+                    {
+                        return i - 1;
+                    }
+                }
+                return notFound;
+            }
+
+            /**
+             * @brief Finds a needle starting at a position in [first, last). The caller guarantees last + needleLength <= the haystack length.
+             */
+            inline std::size_t findSubstring(const char* data, std::size_t first, std::size_t last, const char* needle, std::size_t needleLength)
+            {
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    if (data[i] == needle[0] && std::memcmp(data + i + 1, needle + 1, needleLength - 1) == 0)
+                    {
+                        return i;
+                    }
+                }
+                return notFound;
+            }
+
+            /**
+             * @brief Finds the last needle starting at a position in [first, last), searching backwards.
+             */
+            inline std::size_t findLastSubstring(const char* data, std::size_t first, std::size_t last, const char* needle, std::size_t needleLength)
+            {
+                for (std::size_t i = last; i > first; --i)
+                {
+                    if (data[i - 1] == needle[0] && std::memcmp(data + i, needle + 1, needleLength - 1) == 0)
+                    {
+                        return i - 1;
+                    }
+                }
+                return notFound;
+            }
+
+            /**
+             * @brief Finds the first character contained in a 256-bit membership table.
+             */
+            inline std::size_t findFirstOf(const char* data, std::size_t length, const bool* table)
+            {
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    if (table[static_cast<unsigned char>(data[i])])
+                    {
+                        return i;
+                    }
+                }
+                return notFound;
+            }
+
+            inline std::size_t count(const char* data, std::size_t length, char ch)
+            {
+                std::size_t total = 0;
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    total += data[i] == ch;
+                }
+                return total;
+            }
+
+            /**
+             * @brief Compares eight bytes at a time; on little-endian machines the lowest set bit of
+             *        the XOR of two words is in the first differing byte. The last word of the range
+             *        is loaded so that it ends at the end of the range, overlapping the previous one.
+             */
+            inline std::size_t findMismatch(const char* first, const char* second, std::size_t length)
+            {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                if (length >= 8)
+                {
+                    std::uint64_t firstWord;
+                    std::uint64_t secondWord;
+                    for (std::size_t i = 0; i + 8 < length; i += 8)
+                    {
+                        std::memcpy(&firstWord, first + i, 8);
+                        std::memcpy(&secondWord, second + i, 8);
+                        if (std::uint64_t difference = firstWord ^ secondWord)
+                        {
+                            return i + Detail::countTrailingZeros64(difference) / 8;
+                        }
+                    }
+                    std::memcpy(&firstWord, first + length - 8, 8);
+                    std::memcpy(&secondWord, second + length - 8, 8);
+                    if (std::uint64_t difference = firstWord ^ secondWord)
+                    {
+                        return length - 8 + Detail::countTrailingZeros64(difference) / 8;
+                    }
+                    return notFound;
+                }
+                if (length >= 4)
+                {
+                    std::uint32_t firstWord;
+                    std::uint32_t secondWord;
+                    std::memcpy(&firstWord, first, 4);
+                    std::memcpy(&secondWord, second, 4);
+                    if (std::uint32_t difference = firstWord ^ secondWord)
+                    {
+                        return Detail::countTrailingZeros(difference) / 8;
+                    }
+                    std::memcpy(&firstWord, first + length - 4, 4);
+                    std::memcpy(&secondWord, second + length - 4, 4);
+                    if (std::uint32_t difference = firstWord ^ secondWord)
+                    {
+                        return length - 4 + Detail::countTrailingZeros(difference) / 8;
+                    }
+                    return notFound;
+                }
+#endif
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    if (first[i] != second[i])
+                    {
+                        return i;
+                    }
+                }
+                return notFound;
+            }
+
+            /**
+             * @brief Flips the case of the 26 characters starting at first ('A' lowers, 'a' uppers);
+             *        the source and the destination may be the same.
+             */
+            inline void convertCase(const char* source, char* destination, std::size_t length, char first)
+            {
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    unsigned char ch = static_cast<unsigned char>(source[i]);
+                    bool inRange = static_cast<unsigned char>(ch - first) < 26;
+                    destination[i] = static_cast<char>(ch ^ (inRange << 5));
+                }
+            }
+
+            inline bool equalsIgnoreCase(const char* first, const char* second, std::size_t length)
+            {
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    unsigned char firstChar = static_cast<unsigned char>(first[i]);
+                    unsigned char secondChar = static_cast<unsigned char>(second[i]);
+                    firstChar |= (static_cast<unsigned char>(firstChar - 'A') < 26) << 5;
+                    secondChar |= (static_cast<unsigned char>(secondChar - 'A') < 26) << 5;
+                    if (firstChar != secondChar)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        }
+
+#if USERDEFINED_SIMD_X86
+        namespace Sse2
+        {
+            inline std::uint32_t matchMask(__m128i block, __m128i needle)
+            {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+            }
+
+            inline __m128i load(const char* data)
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            }
+
+            inline std::size_t findChar(const char* data, std::size_t length, char ch)
+            {
+                const __m128i needle = _mm_set1_epi8(ch);
+                std::size_t i = 0;
+
+                for (; i + 16 <= length; i += 16)
+                {
+                    if (std::uint32_t mask = matchMask(load(data + i), needle))
+                    {
+                        return i + Detail::countTrailingZeros(mask);
+                    }
+                }
+
+                std::size_t tail = Scalar::findChar(data + i, length - i, ch);
+                return tail == notFound ? notFound : i + tail;
+            }
+
+            inline std::size_t findLastChar(const char* data, std::size_t length, char ch)
+            {
+                const __m128i needle = _mm_set1_epi8(ch);
+                std::size_t end = length;
+
+                for (; end >= 16; end -= 16)
+                {
+                    if (std::uint32_t mask = matchMask(load(data + end - 16), needle))
+                    {
+                        return end - 16 + Detail::highestBit(mask);
+                    }
+                }
+
+                return Scalar::findLastChar(data, end, ch);
+            }
+
+            inline std::size_t findSubstring(const char* data, std::size_t first, std::size_t last, const char* needle, std::size_t needleLength)
+            {
+                const __m128i firstChar = _mm_set1_epi8(needle[0]);
+                const __m128i lastChar = _mm_set1_epi8(needle[needleLength - 1]);
+                std::size_t i = first;
+
+                for (; i + 16 <= last; i += 16)
+                {
+                    std::uint32_t mask = matchMask(load(data + i), firstChar) & matchMask(load(data + i + needleLength - 1), lastChar);
+                    while (mask)
+                    {
+                        std::size_t position = i + Detail::countTrailingZeros(mask);
+                        if (std::memcmp(data + position + 1, needle + 1, needleLength - 1) == 0)
+                        {
+                            return position;
+                        }
+                        mask &= mask - 1;
+                    }
+                }
+
+                return Scalar::findSubstring(data, i, last, needle, needleLength);
+            }
+
+            inline std::size_t findLastSubstring(const char* data, std::size_t first, std::size_t last, const char* needle, std::size_t needleLength)
+            {
+                const __m128i firstChar = _mm_set1_epi8(needle[0]);
+                const __m128i lastChar = _mm_set1_epi8(needle[needleLength - 1]);
+                std::size_t end = last;
+
+                for (; end >= first + 16; end -= 16)
+                {
+                    std::size_t i = end - 16;
+                    std::uint32_t mask = matchMask(load(data + i), firstChar) & matchMask(load(data + i + needleLength - 1), lastChar);
+                    while (mask)
+                    {
+                        unsigned bit = Detail::highestBit(mask);
+                        if (std::memcmp(data + i + bit + 1, needle + 1, needleLength - 1) == 0)
+                        {
+                            return i + bit;
+                        }
+                        mask &= ~(1u << bit);
+                    }
+                }
+
+                return Scalar::findLastSubstring(data, first, end, needle, needleLength);
+            }
+
+            /**
+             * @brief Finds the first character of a small set (at most 16 characters) by comparing against each one.
+             */
+            inline std::size_t findFirstOf(const char* data, std::size_t length, const char* set, std::size_t setLength, const bool* table)
+            {
+                __m128i needles[16];
+                for (std::size_t s = 0; s < setLength; ++s)
+                {
+                    needles[s] = _mm_set1_epi8(set[s]);
+                }
+
+                std::size_t i = 0;
+                for (; i + 16 <= length; i += 16)
+                {
+                    __m128i block = load(data + i);
+                    __m128i matches = _mm_setzero_si128();
+                    for (std::size_t s = 0; s < setLength; ++s)
+                    {
+                        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, needles[s]));
+                    }
+                    if (std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(matches)))
+                    {
+                        return i + Detail::countTrailingZeros(mask);
+                    }
+                }
+
+                std::size_t tail = Scalar::findFirstOf(data + i, length - i, table);
+                return tail == notFound ? notFound : i + tail;
+            }
+
+            /**
+             * @brief Counts matches 16 bytes at a time; each byte lane of the accumulator counts up to 255 blocks.
+             */
+            inline std::size_t count(const char* data, std::size_t length, char ch)
+            {
+                const __m128i needle = _mm_set1_epi8(ch);
+                std::size_t total = 0;
+                std::size_t i = 0;
+
+                while (i + 16 <= length)
+                {
+                    __m128i accumulator = _mm_setzero_si128();
+                    for (std::size_t blocks = 0; blocks < 255 && i + 16 <= length; ++blocks, i += 16)
+                    {
+                        accumulator = _mm_sub_epi8(accumulator, _mm_cmpeq_epi8(load(data + i), needle));
+                    }
+                    __m128i sums = _mm_sad_epu8(accumulator, _mm_setzero_si128());
+                    total += static_cast<std::size_t>(_mm_cvtsi128_si32(sums)) + static_cast<std::size_t>(_mm_extract_epi16(sums, 4));
+                }
+
+                return total + Scalar::count(data + i, length - i, ch);
+            }
+
+            /**
+             * @brief Compares 16 bytes at a time; the range must hold at least 16 characters, and the
+             *        last block is loaded so that it ends at the end of the range.
+             */
+            inline std::size_t findMismatch(const char* first, const char* second, std::size_t length)
+            {
+                for (std::size_t i = 0; i + 16 < length; i += 16)
+                {
+                    std::uint32_t mask = matchMask(load(first + i), load(second + i));
+                    if (mask != 0xFFFFu)
+                    {
+                        return i + Detail::countTrailingZeros(~mask);
+                    }
+                }
+
+                std::uint32_t mask = matchMask(load(first + length - 16), load(second + length - 16));
+                return mask == 0xFFFFu ? notFound : length - 16 + Detail::countTrailingZeros(~mask);
+            }
+
+            /**
+             * @brief Flips bit 5 of the bytes in [first, first + 25]: biased by 128 - first, they are
+             *        the bytes below -102 as signed values, as SSE2 has no unsigned comparison.
+             */
+            inline __m128i convertCase(__m128i block, __m128i bias, __m128i limit)
+            {
+                __m128i inRange = _mm_cmplt_epi8(_mm_add_epi8(block, bias), limit);
+                return _mm_xor_si128(block, _mm_and_si128(inRange, _mm_set1_epi8(0x20)));
+            }
+
+            /**
+             * @brief Converts 16 bytes at a time; the range must hold at least 16 characters. The last
+             *        block ends at the end of the range: converting a character twice changes nothing.
+             */
+            inline void convertCase(const char* source, char* destination, std::size_t length, char first)
+            {
+                const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80 - first));
+                const __m128i limit = _mm_set1_epi8(-128 + 26);
+                for (std::size_t i = 0; i + 16 < length; i += 16)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), convertCase(load(source + i), bias, limit));
+                }
+                __m128i last = convertCase(load(source + length - 16), bias, limit);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + length - 16), last);
+            }
+
+            /**
+             * @brief Compares the lowercase forms of 16 bytes at a time; the range must hold at least 16 characters.
+             */
+            inline bool equalsIgnoreCase(const char* first, const char* second, std::size_t length)
+            {
+                const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80 - 'A'));
+                const __m128i limit = _mm_set1_epi8(-128 + 26);
+                for (std::size_t i = 0; i + 16 < length; i += 16)
+                {
+                    if (matchMask(convertCase(load(first + i), bias, limit), convertCase(load(second + i), bias, limit)) != 0xFFFFu)
+                    {
+                        return false;
+                    }
+                }
+                std::size_t last = length - 16;
+                return matchMask(convertCase(load(first + last), bias, limit), convertCase(load(second + last), bias, limit)) == 0xFFFFu;
+            }
+        }
+
+        namespace Avx2
+        {
+            USERDEFINED_TARGET_AVX2 inline std::uint32_t matchMask(__m256i block, __m256i needle)
+            {
+                return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+            }
+
+            USERDEFINED_TARGET_AVX2 inline __m256i load(const char* data)
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+            }
+
+            USERDEFINED_TARGET_AVX2 inline std::size_t findChar(const char* data, std::size_t length, char ch)
+            {
+                const __m256i needle = _mm256_set1_epi8(ch);
+                std::size_t i = 0;
+
+                // Two vectors per iteration, with a single branch on the combined result.
+                for (; i + 64 <= length; i += 64)
+                {
+                    __m256i first = _mm256_cmpeq_epi8(load(data + i), needle);
+                    __m256i second = _mm256_cmpeq_epi8(load(data + i + 32), needle);
+                    if (_mm256_movemask_epi8(_mm256_or_si256(first, second)))
+                    {
+                        if (std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(first)))
+                        {
+                            return i + Detail::countTrailingZeros(mask);
+                        }
+                        return i + 32 + Detail::countTrailingZeros(static_cast<std::uint32_t>(_mm256_movemask_epi8(second)));
+                    }
+                }
+
+                for (; i + 32 <= length; i += 32)
+                {
+                    if (std::uint32_t mask = matchMask(load(data + i), needle))
+                    {
+                        return i + Detail::countTrailingZeros(mask);
+                    }
+                }
+
+                std::size_t tail = Sse2::findChar(data + i, length - i, ch);
+                return tail == notFound ? notFound : i + tail;
+            }
+
+            USERDEFINED_TARGET_AVX2 inline std::size_t findLastChar(const char* data, std::size_t length, char ch)
+            {
+                const __m256i needle = _mm256_set1_epi8(ch);
+                std::size_t end = length;
+
+                for (; end >= 32; end -= 32)
+                {
+                    if (std::uint32_t mask = matchMask(load(data + end - 32), needle))
+                    {
+                        return end - 32 + Detail::highestBit(mask);
+                    }
+                }
+
+                return Sse2::findLastChar(data, end, ch);
+            }
+
+            USERDEFINED_TARGET_AVX2 inline std::size_t findSubstring(const char* data, std::size_t first, std::size_t last, const char* needle, std::size_t needleLength)
+            {
+                const __m256i firstChar = _mm256_set1_epi8(needle[0]);
+                const __m256i lastChar = _mm256_set1_epi8(needle[needleLength - 1]);
+                std::size_t i = first;
+
+                for (; i + 32 <= last; i += 32)
+                {
+                    std::uint32_t mask = matchMask(load(data + i), firstChar) & matchMask(load(data + i + needleLength - 1), lastChar);
+                    while (mask)
+                    {
+                        std::size_t position = i + Detail::countTrailingZeros(mask);
+                        if (std::memcmp(data + position + 1, needle + 1, needleLength - 1) == 0)
+                        {
+                            return position;
+                        }
+                        mask &= mask - 1;
+                    }
+                }
+
+                return Sse2::findSubstring(data, i, last, needle, needleLength);
+            }
+
+            USERDEFINED_TARGET_AVX2 inline std::size_t findLastSubstring(const char* data, std::size_t first, std::size_t last, const char* needle, std::size_t needleLength)
+            {
+                const __m256i firstChar = _mm256_set1_epi8(needle[0]);
+                const __m256i lastChar = _mm256_set1_epi8(needle[needleLength - 1]);
+                std::size_t end = last;
+
+                for (; end >= first + 32; end -= 32)
+                {
+                    std::size_t i = end - 32;
+                    std::uint32_t mask = matchMask(load(data + i), firstChar) & matchMask(load(data + i + needleLength - 1), lastChar);
+                    while (mask)
+                    {
+                        unsigned bit = Detail::highestBit(mask);
+                        if (std::memcmp(data + i + bit + 1, needle + 1, needleLength - 1) == 0)
+                        {
+                            return i + bit;
+                        }
+                        mask &= ~(1u << bit);
+                    }
+                }
+
+                return Sse2::findLastSubstring(data, first, end, needle, needleLength);
+            }
+
+            /**
+             * @brief Finds the first character of an arbitrary set with nibble lookup tables.
+             *
+             * A character is in the set when bit (high nibble % 8) of lowTable[low nibble] is set;
+             * lowTable is taken from the first half of the tables for high nibbles 0-7 and from the
+             * second half for 8-15, which is selected by the sign bit of the character itself.
+             */
+            USERDEFINED_TARGET_AVX2 inline std::size_t findFirstOf(const char* data, std::size_t length, const std::uint8_t* nibbleTables, const bool* table)
+            {
+                const __m128i lowHalf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nibbleTables));
+                const __m128i highHalf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nibbleTables + 16));
+                const __m256i lowTable = _mm256_broadcastsi128_si256(lowHalf);
+                const __m256i highTable = _mm256_broadcastsi128_si256(highHalf);
+                const __m256i bitTable = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                                          1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+                const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+                std::size_t i = 0;
+
+                for (; i + 32 <= length; i += 32)
+                {
+                    __m256i block = load(data + i);
+                    __m256i lowNibbles = _mm256_and_si256(block, nibbleMask);
+                    __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibbleMask);
+                    __m256i rows = _mm256_blendv_epi8(_mm256_shuffle_epi8(lowTable, lowNibbles), _mm256_shuffle_epi8(highTable, lowNibbles), block);
+                    __m256i bits = _mm256_shuffle_epi8(bitTable, highNibbles);
+                    __m256i misses = _mm256_cmpeq_epi8(_mm256_and_si256(rows, bits), _mm256_setzero_si256());
+                    if (std::uint32_t mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(misses)))
+                    {
+                        return i + Detail::countTrailingZeros(mask);
+                    }
+                }
+
+                std::size_t tail = Scalar::findFirstOf(data + i, length - i, table);
+                return tail == notFound ? notFound : i + tail;
+            }
+
+            USERDEFINED_TARGET_AVX2 inline std::size_t count(const char* data, std::size_t length, char ch)
+            {
+                const __m256i needle = _mm256_set1_epi8(ch);
+                std::size_t total = 0;
+                std::size_t i = 0;
+
+                while (i + 32 <= length)
+                {
+                    __m256i accumulator = _mm256_setzero_si256();
+                    for (std::size_t blocks = 0; blocks < 255 && i + 32 <= length; ++blocks, i += 32)
+                    {
+                        accumulator = _mm256_sub_epi8(accumulator, _mm256_cmpeq_epi8(load(data + i), needle));
+                    }
+                    __m256i sums = _mm256_sad_epu8(accumulator, _mm256_setzero_si256());
+                    total += static_cast<std::size_t>(_mm256_extract_epi64(sums, 0)) + static_cast<std::size_t>(_mm256_extract_epi64(sums, 1))
+                           + static_cast<std::size_t>(_mm256_extract_epi64(sums, 2)) + static_cast<std::size_t>(_mm256_extract_epi64(sums, 3));
+                }
+
+                return total + Sse2::count(data + i, length - i, ch);
+            }
+
+            /**
+             * @brief Compares 128 bytes per iteration with a single branch; the range must hold at
+             *        least 16 characters, and the last block is loaded so that it ends at the end of the range.
+             */
+            USERDEFINED_TARGET_AVX2 inline std::size_t findMismatch(const char* first, const char* second, std::size_t length)
+            {
+                if (length < 32)
+                {
+                    return Sse2::findMismatch(first, second, length);
+                }
+
+                std::size_t i = 0;
+                for (; i + 128 <= length; i += 128)
+                {
+                    __m256i block0 = _mm256_cmpeq_epi8(load(first + i), load(second + i));
+                    __m256i block1 = _mm256_cmpeq_epi8(load(first + i + 32), load(second + i + 32));
+                    __m256i block2 = _mm256_cmpeq_epi8(load(first + i + 64), load(second + i + 64));
+                    __m256i block3 = _mm256_cmpeq_epi8(load(first + i + 96), load(second + i + 96));
+                    __m256i all = _mm256_and_si256(_mm256_and_si256(block0, block1), _mm256_and_si256(block2, block3));
+                    if (static_cast<std::uint32_t>(_mm256_movemask_epi8(all)) != 0xFFFFFFFFu)
+                    {
+                        // Found below; the 32-byte loop locates the differing block.
+                        break;
+                    }
+                }
+
+                for (; i + 32 < length; i += 32)
+                {
+                    std::uint32_t mask = matchMask(load(first + i), load(second + i));
+                    if (mask != 0xFFFFFFFFu)
+                    {
+                        return i + Detail::countTrailingZeros(~mask);
+                    }
+                }
+
+                std::uint32_t mask = matchMask(load(first + length - 32), load(second + length - 32));
+                return mask == 0xFFFFFFFFu ? notFound : length - 32 + Detail::countTrailingZeros(~mask);
+            }
+
+            USERDEFINED_TARGET_AVX2 inline __m256i convertCase(__m256i block, __m256i bias, __m256i limit)
+            {
+                __m256i inRange = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(block, bias));
+                return _mm256_xor_si256(block, _mm256_and_si256(inRange, _mm256_set1_epi8(0x20)));
+            }
+
+            /**
+             * @brief Converts 32 bytes at a time like the SSE2 kernel; the range must hold at least 16 characters.
+             */
+            USERDEFINED_TARGET_AVX2 inline void convertCase(const char* source, char* destination, std::size_t length, char first)
+            {
+                if (length < 32)
+                {
+                    Sse2::convertCase(source, destination, length, first);
+                    return;
+                }
+
+                const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80 - first));
+                const __m256i limit = _mm256_set1_epi8(-128 + 26);
+                for (std::size_t i = 0; i + 32 < length; i += 32)
+                {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), convertCase(load(source + i), bias, limit));
+                }
+                __m256i last = convertCase(load(source + length - 32), bias, limit);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + length - 32), last);
+            }
+
+            /**
+             * @brief Compares the lowercase forms of 32 bytes at a time; the range must hold at least 16 characters.
+             */
+            USERDEFINED_TARGET_AVX2 inline bool equalsIgnoreCase(const char* first, const char* second, std::size_t length)
+            {
+                if (length < 32)
+                {
+                    return Sse2::equalsIgnoreCase(first, second, length);
+                }
+
+                const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80 - 'A'));
+                const __m256i limit = _mm256_set1_epi8(-128 + 26);
+                for (std::size_t i = 0; i + 32 < length; i += 32)
+                {
+                    if (matchMask(convertCase(load(first + i), bias, limit), convertCase(load(second + i), bias, limit)) != 0xFFFFFFFFu)
+                    {
+                        return false;
+                    }
+                }
+                std::size_t last = length - 32;
+                return matchMask(convertCase(load(first + last), bias, limit), convertCase(load(second + last), bias, limit)) == 0xFFFFFFFFu;
+            }
+        }
+#endif
+
+        // #region Dispatching Kernels
+
+        /**
+         * @brief Finds the first occurrence of a character.
+         *
+         * @param data The characters to search.
+         * @param length The number of characters.
+         * @param ch The character to find.
+         * @return The position of the character, or notFound.
+         */
+        inline std::size_t findChar(const char* data, std::size_t length, char ch)
+        {
+#if USERDEFINED_SIMD_X86
+            switch (activeLevel())
+            {
+                case Level::AVX2: return Avx2::findChar(data, length, ch);
+                case Level::SSE2: return Sse2::findChar(data, length, ch);
+                default: break;
+            }
+#endif
+            return Scalar::findChar(data, length, ch);
+        }
+
+        /**
+         * @brief Finds the last occurrence of a character.
+         *
+         * @param data The characters to search.
+         * @param length The number of characters.
+         * @param ch The character to find.
+         * @return The position of the character, or notFound.
+         */
+        inline std::size_t findLastChar(const char* data, std::size_t length, char ch)
+        {
+#if USERDEFINED_SIMD_X86
+            switch (activeLevel())
+            {
+                case Level::AVX2: return Avx2::findLastChar(data, length, ch);
+                case Level::SSE2: return Sse2::findLastChar(data, length, ch);
+                default: break;
+            }
+#endif
+            return Scalar::findLastChar(data, length, ch);
+        }
+
+        /**
+         * @brief Finds the first occurrence of a substring.
+         *
+         * Candidate positions are those where both the first and the last character of the
+         * needle match; they are found a vector at a time and then verified with memcmp.
+         *
+         * @param data The characters to search.
+         * @param length The number of characters.
+         * @param needle The substring to find.
+         * @param needleLength The length of the substring.
+         * @return The position of the substring, or notFound. An empty needle is found at 0.
+         */
+        inline std::size_t findSubstring(const char* data, std::size_t length, const char* needle, std::size_t needleLength)
+        {
+            if (needleLength == 0)
+            {
+                return 0;
+            }
+            if (needleLength > length)
+            {
+                return notFound;
+            }
+            if (needleLength == 1)
+            {
+                return findChar(data, length, needle[0]);
+            }
+
+            std::size_t last = length - needleLength + 1;
+#if USERDEFINED_SIMD_X86
+            switch (activeLevel())
+            {
+                case Level::AVX2: return Avx2::findSubstring(data, 0, last, needle, needleLength);
+                case Level::SSE2: return Sse2::findSubstring(data, 0, last, needle, needleLength);
+                default: break;
+            }
+#endif
+            return Scalar::findSubstring(data, 0, last, needle, needleLength);
+        }
+
+        /**
+         * @brief Finds the last occurrence of a substring.
+         *
+         * @param data The characters to search.
+         * @param length The number of characters.
+         * @param needle The substring to find.
+         * @param needleLength The length of the substring.
+         * @return The position of the substring, or notFound. An empty needle is found at length.
+         */
+        inline std::size_t findLastSubstring(const char* data, std::size_t length, const char* needle, std::size_t needleLength)
+        {
+            if (needleLength == 0)
+            {
+                return length;
+            }
+            if (needleLength > length)
+            {
+                return notFound;
+            }
+            if (needleLength == 1)
+            {
+                return findLastChar(data, length, needle[0]);
+            }
+
+            std::size_t last = length - needleLength + 1;
+#if USERDEFINED_SIMD_X86
+            switch (activeLevel())
+            {
+                case Level::AVX2: return Avx2::findLastSubstring(data, 0, last, needle, needleLength);
+                case Level::SSE2: return Sse2::findLastSubstring(data, 0, last, needle, needleLength);
+                default: break;
+            }
+#endif
+            return Scalar::findLastSubstring(data, 0, last, needle, needleLength);
+        }
+
+        /**
+         * @brief Finds the first character that belongs to a set whose tables are already built.
+         *
+         * @param data The characters to search.
+         * @param length The number of characters.
+         * @param set The characters to look for.
+         * @return The position of the first matching character, or notFound.
+         */
+        inline std::size_t findFirstOf(const char* data, std::size_t length, const CharacterSet& set)
+        {
+            if (set.size() <= 1)
+            {
+                return set.size() == 0 ? notFound : findChar(data, length, set.characters()[0]);
+            }
+
+#if USERDEFINED_SIMD_X86
+            Level level = activeLevel();
+            if (level == Level::AVX2 && length >= 32)
+            {
+                return Avx2::findFirstOf(data, length, set.nibbleTables(), set.table());
+            }
+            if (level >= Level::SSE2 && set.size() <= 16)
+            {
+                return Sse2::findFirstOf(data, length, set.characters(), set.size(), set.table());
+            }
+#endif
+            return Scalar::findFirstOf(data, length, set.table());
+        }
+
+        /**
+         * @brief Finds the first character that belongs to a set.
+         *
+         * @param data The characters to search.
+         * @param length The number of characters.
+         * @param set The characters to look for.
+         * @param setLength The number of characters in the set.
+         * @return The position of the first matching character, or notFound.
+         */
+        inline std::size_t findFirstOf(const char* data, std::size_t length, const char* set, std::size_t setLength)
+        {
+            if (setLength == 0)
+            {
+                return notFound;
+            }
+            if (setLength == 1)
+            {
+                return findChar(data, length, set[0]);
+            }
+
+            return findFirstOf(data, length, CharacterSet(set, setLength));
+        }
+
+        /**
+         * @brief Counts the occurrences of a character.
+         *
+         * @param data The characters to search.
+         * @param length The number of characters.
+         * @param ch The character to count.
+         * @return The number of occurrences.
+         */
+        inline std::size_t count(const char* data, std::size_t length, char ch)
+        {
+#if USERDEFINED_SIMD_X86
+            switch (activeLevel())
+            {
+                case Level::AVX2: return Avx2::count(data, length, ch);
+                case Level::SSE2: return Sse2::count(data, length, ch);
+                default: break;
+            }
+#endif
+            return Scalar::count(data, length, ch);
+        }
+
+        /**
+         * @brief Finds the first position where two character ranges differ.
+         *
+         * Short ranges are compared a 64-bit word at a time, long ones a vector at a time;
+         * the search stops at the first vector that contains a difference.
+         *
+         * @param first The first range.
+         * @param second The second range.
+         * @param length The number of characters in each range.
+         * @return The position of the first differing character, or notFound if the ranges are equal.
+         */
+        inline std::size_t findMismatch(const char* first, const char* second, std::size_t length)
+        {
+#if USERDEFINED_SIMD_X86
+            if (length >= 16)
+            {
+                // The AVX2 kernel cannot be inlined here; below 64 characters the SSE2 one, which can, is faster.
+                Level level = activeLevel();
+                if (level == Level::AVX2 && length >= 64)
+                {
+                    return Avx2::findMismatch(first, second, length);
+                }
+                if (level != Level::Scalar)
+                {
+                    return Sse2::findMismatch(first, second, length);
+                }
+            }
+#endif
+            return Scalar::findMismatch(first, second, length);
+        }
+
+        /**
+         * @brief Converts ASCII characters to lowercase; other bytes, including UTF-8 sequences, are copied unchanged.
+         *
+         * @param source The characters to convert.
+         * @param destination Where to write the result; either source itself or a range not overlapping it.
+         * @param length The number of characters.
+         */
+        inline void toLower(const char* source, char* destination, std::size_t length)
+        {
+#if USERDEFINED_SIMD_X86
+            if (length >= 16)
+            {
+                Level level = activeLevel();
+                if (level == Level::AVX2 && length >= 64)
+                {
+                    Avx2::convertCase(source, destination, length, 'A');
+                    return;
+                }
+                if (level != Level::Scalar)
+                {
+                    Sse2::convertCase(source, destination, length, 'A');
+                    return;
+                }
+            }
+#endif
+            Scalar::convertCase(source, destination, length, 'A');
+        }
+
+        /**
+         * @brief Converts ASCII characters to uppercase; other bytes, including UTF-8 sequences, are copied unchanged.
+         *
+         * @param source The characters to convert.
+         * @param destination Where to write the result; either source itself or a range not overlapping it.
+         * @param length The number of characters.
+         */
+        inline void toUpper(const char* source, char* destination, std::size_t length)
+        {
+#if USERDEFINED_SIMD_X86
+            if (length >= 16)
+            {
+                Level level = activeLevel();
+                if (level == Level::AVX2 && length >= 64)
+                {
+                    Avx2::convertCase(source, destination, length, 'a');
+                    return;
+                }
+                if (level != Level::Scalar)
+                {
+                    Sse2::convertCase(source, destination, length, 'a');
+                    return;
+                }
+            }
+#endif
+            Scalar::convertCase(source, destination, length, 'a');
+        }
+
+        /**
+         * @brief Checks whether two character ranges are equal, ignoring the case of ASCII letters.
+         *
+         * @param first The first range.
+         * @param second The second range.
+         * @param length The number of characters in each range.
+         * @return true if the ranges differ only in the case of ASCII letters.
+         */
+        inline bool equalsIgnoreCase(const char* first, const char* second, std::size_t length)
+        {
+#if USERDEFINED_SIMD_X86
+            if (length >= 16)
+            {
+                Level level = activeLevel();
+                if (level == Level::AVX2 && length >= 64)
+                {
+                    return Avx2::equalsIgnoreCase(first, second, length);
+                }
+                if (level != Level::Scalar)
+                {
+                    return Sse2::equalsIgnoreCase(first, second, length);
+                }
+            }
+#endif
+            return Scalar::equalsIgnoreCase(first, second, length);
+        }
+
+        // #endregion
+    }
+}
+
+#endif // SIMD_HPP
@@ -0,0 +1,321 @@
+/**************************************************************************************************
+ * @file Split.hpp
+ *
+ * @brief Lazy, zero-copy splitting of strings into tokens.
+ *
+ * This file contains split() and splitAny(), which return a range over the tokens
+ * of a string separated by a character, a multi-character delimiter or any
+ * character of a set. The tokens are StringViews into the original characters and
+ * are found one at a time with the vectorized search of Simd.hpp, so iterating
+ * over a split allocates nothing. toVector() collects the tokens, optionally
+ * splitting a large input on several threads.
+ *
+ **************************************************************************************************/
+
+#ifndef SPLIT_HPP
+#define SPLIT_HPP
+
+#include "StringView.hpp"
+
+#include <cassert>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace UserDefined
+{
+    namespace Detail
+    {
+        /**
+         * @struct CharDelimiter
+         * @brief Splits at every occurrence of one character.
+         */
+        struct CharDelimiter
+        {
+            static constexpr bool singleCharacter = true;   ///< Matches never overlap, so the input may be cut anywhere.
+
+            char ch;
+
+            std::size_t find(const char* data, std::size_t length) const { return Simd::findChar(data, length, ch); }
+            std::size_t length() const { return 1; }
+        };
+
+        /**
+         * @struct AnyOfDelimiter
+         * @brief Splits at every character that belongs to a set.
+         */
+        struct AnyOfDelimiter
+        {
+            static constexpr bool singleCharacter = true;   ///< Matches never overlap, so the input may be cut anywhere.
+
+            Simd::CharacterSet set;
+
+            std::size_t find(const char* data, std::size_t length) const { return Simd::findFirstOf(data, length, set); }
+            std::size_t length() const { return 1; }
+        };
+
+        /**
+         * @struct SubstringDelimiter
+         * @brief Splits at every (non-overlapping, leftmost) occurrence of a substring.
+         */
+        struct SubstringDelimiter
+        {
+            static constexpr bool singleCharacter = false;  ///< Matches may overlap, so the input is split sequentially.
+
+            StringView needle;
+
+            std::size_t find(const char* data, std::size_t length) const { return Simd::findSubstring(data, length, needle.data(), needle.length()); }
+            std::size_t length() const { return needle.length(); }
+        };
+    }
+
+    /**
+     * @class SplitRange
+     * @brief The tokens of a string, found lazily as the range is iterated.
+     *
+     * Like Python's str.split() with a separator, n delimiters give n + 1 tokens, and
+     * empty tokens (between adjacent delimiters, or at either end) are kept. The tokens
+     * refer to the characters of the split string, which must outlive them.
+     *
+     * @tparam Delimiter How delimiters are found (see Detail::CharDelimiter and friends).
+     */
+    template <typename Delimiter>
+    class SplitRange
+    {
+    public:
+        /**
+         * @class Iterator
+         * @brief A forward iterator over the tokens.
+         */
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = StringView;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const StringView*;
+            using reference = const StringView&;
+
+            Iterator()
+                : _range(nullptr)
+                , _finished(true)
+                , _last(true)
+            {
+            }
+
+            reference operator*() const { return _token; }
+            pointer operator->() const { return &_token; }
+
+            Iterator& operator++()
+            {
+                _advance();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator previous = *this;
+                _advance();
+                return previous;
+            }
+
+            bool operator==(const Iterator& compareIterator) const
+            {
+                return _finished == compareIterator._finished && (_finished || _token.data() == compareIterator._token.data());
+            }
+
+            bool operator!=(const Iterator& compareIterator) const
+            {
+                return !(*this == compareIterator);
+            }
+
+        private:
+            friend class SplitRange;
+
+            Iterator(const SplitRange* range, StringView text)
+                : _range(range)
+                , _rest(text)
+                , _finished(false)
+                , _last(false)
+            {
+                _advance();
+            }
+
+            /**
+             * @brief Moves to the next token: up to the next delimiter, or the rest of the text.
+             */
+            void _advance()
+            {
+                if (_last)
+                {
+                    _finished = true;
+                    return;
+                }
+
+                std::size_t found = _range->_delimiter.find(_rest.data(), _rest.length());
+                if (found == Simd::notFound)
+                {
+                    _token = _rest;
+                    _last = true;
+                    return;
+                }
+
+                _token = _rest.substr(0, found);
+                _rest.remove_prefix(found + _range->_delimiter.length());
+            }
+
+            const SplitRange* _range;   ///< The range being iterated (holds the delimiter).
+            StringView _token;          ///< The current token.
+            StringView _rest;           ///< The text after the current token's delimiter.
+            bool _finished;             ///< Whether the iterator is past the last token.
+            bool _last;                 ///< Whether the current token is the last one.
+        };
+
+        using iterator = Iterator;
+        using const_iterator = Iterator;
+
+        /**
+         * @brief Constructs the range; use split() or splitAny() instead.
+         *
+         * @param text The text to split.
+         * @param delimiter How to find the delimiters.
+         */
+        SplitRange(StringView text, const Delimiter& delimiter)
+            : _text(text)
+            , _delimiter(delimiter)
+        {
+        }
+
+        Iterator begin() const { return Iterator(this, _text); }
+        Iterator end() const { return Iterator(); }
+
+        /**
+         * @brief Collects all tokens.
+         *
+         * With more than one thread, inputs large enough to be worth it are cut into
+         * roughly equal parts at delimiters and the parts are split concurrently; the
+         * tokens come out in the same order either way. Multi-character delimiters are
+         * always split on the calling thread, since their matches may overlap a cut.
+         *
+         * @param threadCount The number of threads to use, including the calling thread.
+         * @return The tokens, in order.
+         */
+        std::vector<StringView> toVector(std::size_t threadCount = 1) const
+        {
+            std::vector<StringView> tokens;
+
+            threadCount = std::min(threadCount, _text.length() / _minimumParallelLength);
+            if (!Delimiter::singleCharacter || threadCount <= 1)
+            {
+                _collect(_text, tokens);
+                return tokens;
+            }
+
+            // Each part but the last ends right before a delimiter, and the next part starts after it.
+            std::vector<std::size_t> starts(1, 0);
+            for (std::size_t t = 1; t < threadCount; ++t)
+            {
+                std::size_t cut = t * (_text.length() / threadCount);
+                if (cut < starts.back())
+                {
+                    continue;
+                }
+                std::size_t found = _delimiter.find(_text.data() + cut, _text.length() - cut);
+                if (found == Simd::notFound)
+                {
+                    break;
+                }
+                starts.push_back(cut + found + 1);
+            }
+
+            std::vector<StringView> parts;
+            for (std::size_t part = 0; part < starts.size(); ++part)
+            {
+                std::size_t partEnd = part + 1 < starts.size() ? starts[part + 1] - 1 : _text.length();
+                parts.push_back(_text.substr(starts[part], partEnd - starts[part]));
+            }
+
+            std::vector<std::vector<StringView>> partTokens(parts.size());
+            std::vector<std::thread> threads;
+            for (std::size_t part = 1; part < parts.size(); ++part)
+            {
+                threads.emplace_back([this, &parts, &partTokens, part]() {
+                    _collect(parts[part], partTokens[part]);
+                });
+            }
+            _collect(parts[0], partTokens[0]);
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+
+            std::size_t tokenCount = 0;
+            for (const auto& part : partTokens)
+            {
+                tokenCount += part.size();
+            }
+            tokens.reserve(tokenCount);
+            for (const auto& part : partTokens)
+            {
+                tokens.insert(tokens.end(), part.begin(), part.end());
+            }
+            return tokens;
+        }
+
+    private:
+        static constexpr std::size_t _minimumParallelLength = 1 << 20;     ///< The least input per thread worth a thread.
+
+        /**
+         * @brief Appends the tokens of part of the text to a vector.
+         */
+        void _collect(StringView text, std::vector<StringView>& tokens) const
+        {
+            for (StringView token : SplitRange(text, _delimiter))
+            {
+                tokens.push_back(token);
+            }
+        }
+
+        StringView _text;           ///< The text to split.
+        Delimiter _delimiter;       ///< How to find the delimiters.
+    };
+
+    /**
+     * @brief Splits a string at every occurrence of a character.
+     *
+     * @param text The string to split; it must outlive the range and its tokens.
+     * @param delimiter The character separating the tokens.
+     * @return A lazy range of the tokens.
+     */
+    inline SplitRange<Detail::CharDelimiter> split(StringView text, char delimiter)
+    {
+        return SplitRange<Detail::CharDelimiter>(text, Detail::CharDelimiter{ delimiter });
+    }
+
+    /**
+     * @brief Splits a string at every occurrence of a multi-character delimiter.
+     *
+     * @param text The string to split; it must outlive the range and its tokens.
+     * @param delimiter The non-empty string separating the tokens; it must outlive the range.
+     * @return A lazy range of the tokens.
+     */
+    inline SplitRange<Detail::SubstringDelimiter> split(StringView text, StringView delimiter)
+    {
+        assert(!delimiter.empty());
+        return SplitRange<Detail::SubstringDelimiter>(text, Detail::SubstringDelimiter{ delimiter });
+    }
+
+    /**
+     * @brief Splits a string at every character that is one of the given characters.
+     *
+     * @param text The string to split; it must outlive the range and its tokens.
+     * @param delimiters The characters that separate the tokens.
+     * @return A lazy range of the tokens.
+     */
+    inline SplitRange<Detail::AnyOfDelimiter> splitAny(StringView text, StringView delimiters)
+    {
+        return SplitRange<Detail::AnyOfDelimiter>(text, Detail::AnyOfDelimiter{ Simd::CharacterSet(delimiters.data(), delimiters.length()) });
+    }
+}
+
+#endif // SPLIT_HPP
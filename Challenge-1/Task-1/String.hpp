@@ -5,31 +5,203 @@
  *
  * This file contains the definition of a simple string class that provides
  * basic string functionality similar to std::string. It supports dynamic
- * resizing and implements the RAII idiom.
+ * resizing and implements the RAII idiom. Short strings are stored inline
+ * (small-string optimization) and never touch the heap; longer strings are
+ * allocated from a MemoryResource.
  *
  **************************************************************************************************/
 
 #ifndef STRING_HPP
 #define STRING_HPP
 
+#include "FixedString.hpp"
+#include "Instrumentation.hpp"
+#include "MemoryResource.hpp"
+#include "Numeric.hpp"
+#include "StringView.hpp"
+
 #include <iostream>
 #include <cstring>
 #include <memory>
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace UserDefined
 {
+    /**
+     * @class StringPiece
+     * @brief A borrowed run of characters; the leaf of a concatenation expression.
+     */
+    class StringPiece
+    {
+    public:
+        /**
+         * @brief Constructs a piece referring to the given characters.
+         *
+         * @param pieceData The first character of the piece.
+         * @param pieceLength The number of characters in the piece.
+         */
+        StringPiece(const char* pieceData, std::size_t pieceLength)
+            : _pieceData(pieceData)
+            , _pieceLength(pieceLength)
+        {
+        }
+
+        /**
+         * @brief Gets the characters of the piece. They are not null-terminated.
+         *
+         * @return A pointer to the first character of the piece.
+         */
+        const char* data() const
+        {
+            return _pieceData;
+        }
+
+        /**
+         * @brief Gets the number of characters in the piece.
+         *
+         * @return The length of the piece.
+         */
+        std::size_t length() const
+        {
+            return _pieceLength;
+        }
+
+        /**
+         * @brief Copies the characters of the piece to a destination buffer.
+         *
+         * @param destination The buffer to copy to.
+         * @return A pointer just past the last copied character.
+         */
+        char* copyTo(char* destination) const
+        {
+            return std::copy(_pieceData, _pieceData + _pieceLength, destination);
+        }
+
+        /**
+         * @brief Checks whether the piece equals the characters at the given position.
+         *
+         * @param characters The characters to compare with; must hold length() characters.
+         * @return True if the characters are equal, false otherwise.
+         */
+        bool matches(const char* characters) const
+        {
+            return _pieceLength == 0 || std::memcmp(_pieceData, characters, _pieceLength) == 0;
+        }
+
+    private:
+        const char* _pieceData;     ///< The characters of the piece (not owned).
+        std::size_t _pieceLength;   ///< The number of characters in the piece.
+    };
+
+    /**
+     * @class StringConcat
+     * @brief A lazy concatenation of two operands, produced by operator+.
+     *
+     * The expression only records its operands; the characters are copied once,
+     * into a single exactly-sized buffer, when the expression is converted to a
+     * String. Operands are borrowed; operator+ only returns an expression when
+     * none of them is a temporary String, so an `auto` variable holding one stays
+     * valid for as long as the named operands it refers to.
+     *
+     * @tparam Left The type of the left operand (a StringPiece or another StringConcat).
+     * @tparam Right The type of the right operand (a StringPiece or another StringConcat).
+     */
+    template <typename Left, typename Right>
+    class StringConcat
+    {
+    public:
+        /**
+         * @brief Constructs the expression from its two operands.
+         *
+         * @param left The left operand.
+         * @param right The right operand.
+         */
+        StringConcat(const Left& left, const Right& right)
+            : _left(left)
+            , _right(right)
+        {
+        }
+
+        /**
+         * @brief Gets the length of the concatenated string.
+         *
+         * @return The total number of characters of both operands.
+         */
+        std::size_t length() const
+        {
+            return _left.length() + _right.length();
+        }
+
+        /**
+         * @brief Copies the concatenated characters to a destination buffer.
+         *
+         * @param destination The buffer to copy to; must hold length() characters.
+         * @return A pointer just past the last copied character.
+         */
+        char* copyTo(char* destination) const
+        {
+            return _right.copyTo(_left.copyTo(destination));
+        }
+
+        /**
+         * @brief Checks whether the concatenated characters equal the characters at the given position.
+         *
+         * @param characters The characters to compare with; must hold length() characters.
+         * @return True if the characters are equal, false otherwise.
+         */
+        bool matches(const char* characters) const
+        {
+            return _left.matches(characters) && _right.matches(characters + _left.length());
+        }
+
+    private:
+        Left _left;     ///< The left operand.
+        Right _right;   ///< The right operand.
+    };
+
     /**
      * @class String
      * @brief A simple string class.
      *
      * This class provides basic string functionality similar to std::string.
      * It supports dynamic resizing and implements the RAII idiom.
+     *
+     * Strings of up to _localCapacity characters live in an inline buffer
+     * inside the object; only longer strings allocate memory.
+     *
+     * Heap buffers come from a MemoryResource, chosen at construction and kept for
+     * the lifetime of the string (defaultResource() unless one is passed). Like
+     * std::pmr::string, copies use the default resource, moves keep the source's
+     * resource, and assignment never changes the resource of the target.
+     *
+     * Compiled with USERDEFINED_STRING_INSTRUMENTATION, strings report their heap
+     * allocations, copies and moves to the per-thread counters of Instrumentation.hpp.
      */
-    class String
+    class USERDEFINED_INSTRUMENTATION_ABI String
     {
     public:
+        /// Returned by the search functions when nothing is found.
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /**
+         * @struct OwnedBuffer
+         * @brief A heap buffer handed over to or from a String without copying.
+         *
+         * The buffer holds capacity + 1 characters, allocated with new char[], and
+         * data[length] is the terminating null character.
+         */
+        struct OwnedBuffer
+        {
+            std::unique_ptr<char[]> data;   ///< The characters.
+            std::size_t length;             ///< The number of characters in use.
+            std::size_t capacity;           ///< The number of characters the buffer can hold, not counting the null character.
+        };
 
         // #region Constructors/Destruction
 
@@ -39,10 +211,21 @@ namespace UserDefined
          * Constructs an empty string.
          */
         String()
+            : String(defaultResource())
+        {
+        }
+
+        /**
+         * @brief Constructs an empty string that allocates from the given resource.
+         *
+         * @param resource The memory resource for the heap buffer.
+         */
+        explicit String(MemoryResource* resource)
             : _strLength(0)
-            , _strData(std::make_unique<char[]>(1))
+            , _strData(_localBuffer)
+            , _strResource(resource)
         {
-            _strData[0] = '\0';
+            _localBuffer[0] = '\0';
         }
 
         /**
@@ -51,14 +234,12 @@ namespace UserDefined
          * Constructs a string from a C-string.
          *
          * @param inputString The C-string to construct from.
+         * @param resource The memory resource for the heap buffer.
          */
-        String(const char* inputString)
-            : _strLength(std::strlen(inputString))
-            , _strData(std::make_unique<char[]>(_strLength + 1))
+        String(const char* inputString, MemoryResource* resource = defaultResource())
+            : String(resource)
         {
-            std::copy(inputString, inputString + _strLength, _strData.get());
-
-            _strData[_strLength] = '\0';
+            _assign(inputString, std::strlen(inputString));
         }
 
         /**
@@ -67,50 +248,128 @@ namespace UserDefined
          * Constructs a string from a std::vector<char>.
          *
          * @param inputVector The std::vector<char> to construct from.
+         * @param resource The memory resource for the heap buffer.
+         */
+        String(const std::vector<char>& inputVector, MemoryResource* resource = defaultResource())
+            : String(resource)
+        {
+            _assign(inputVector.data(), inputVector.size());
+        }
+
+        /**
+         * @brief Parameterized constructor.
+         *
+         * Constructs a string from a copy of the characters of a view.
+         *
+         * @param inputView The characters to copy.
+         * @param resource The memory resource for the heap buffer.
+         */
+        explicit String(StringView inputView, MemoryResource* resource = defaultResource())
+            : String(resource)
+        {
+            _assign(inputView.data(), inputView.length());
+        }
+
+        /**
+         * @brief Adopting constructor.
+         *
+         * Takes ownership of a buffer allocated with new char[capacity + 1], without copying
+         * its characters, e.g. one that a read() or recv() call has just filled. The string
+         * frees it through newDeleteResource(), which it uses from then on.
+         *
+         * @param buffer The buffer; the null character is written at buffer[length].
+         * @param length The number of characters in the buffer.
+         * @param capacity The number of characters the buffer can hold (its size minus one); at least length.
          */
-        String(const std::vector<char>& inputVector)
-            : _strLength(inputVector.size())
-            , _strData(std::make_unique<char[]>(_strLength + 1))
+        String(std::unique_ptr<char[]> buffer, std::size_t length, std::size_t capacity)
+            : String(newDeleteResource())
         {
-            std::copy(inputVector.begin(), inputVector.end(), _strData.get());
+            assert(length <= capacity);
+            _setHeapBuffer(buffer.release(), capacity);
+            _strLength = length;
             _strData[_strLength] = '\0';
+            Instrumentation::recordAllocation(capacity + 1);
+        }
+
+        /**
+         * @brief Adopting constructor.
+         *
+         * Takes ownership of a buffer released by another String (see release()), without copying.
+         *
+         * @param buffer The buffer.
+         */
+        explicit String(OwnedBuffer&& buffer)
+            : String(std::move(buffer.data), buffer.length, buffer.capacity)
+        {
+        }
+
+        /**
+         * @brief Converting constructor.
+         *
+         * Materializes a concatenation expression (the result of operator+) with a single allocation.
+         *
+         * @param expression The concatenation expression to evaluate.
+         * @param resource The memory resource for the heap buffer.
+         */
+        template <typename Left, typename Right>
+        String(const StringConcat<Left, Right>& expression, MemoryResource* resource = defaultResource())
+            : String(resource)
+        {
+            expression.copyTo(_prepare(expression.length()));
         }
 
 
         /**
          * @brief Copy constructor.
          *
-         * Constructs a string as a copy of another string.
+         * Constructs a string as a copy of another string, allocating from the default resource.
          *
          * @param sourceString The string to copy.
          */
         String(const String& sourceString)
-            : _strLength(sourceString._strLength)
-            , _strData(std::make_unique<char[]>(_strLength + 1))
+            : String(sourceString, defaultResource())
         {
-            std::copy(sourceString._strData.get(), sourceString._strData.get() + _strLength, _strData.get());
+        }
 
-            _strData[_strLength] = '\0';
+        /**
+         * @brief Copy constructor with an explicit resource.
+         *
+         * Constructs a string as a copy of another string, allocating from the given resource.
+         *
+         * @param sourceString The string to copy.
+         * @param resource The memory resource for the heap buffer.
+         */
+        String(const String& sourceString, MemoryResource* resource)
+            : String(resource)
+        {
+            Instrumentation::recordCopy();
+            _assign(sourceString._strData, sourceString._strLength);
+            _copyHash(sourceString);
         }
 
         /**
          * @brief Move constructor.
          *
          * Constructs a string by taking ownership of the data of another string.
+         * Inline (short) strings are copied, as there is no buffer to steal.
+         * The new string uses the resource of the source.
          *
          * @param sourceString The string to move.
          */
         String(String&& sourceString) noexcept
-            : _strLength(sourceString._strLength)
-            , _strData(std::move(sourceString._strData))
+            : String(sourceString._strResource)
         {
-            sourceString._strLength = 0;
+            Instrumentation::recordMove();
+            _steal(sourceString);
         }
 
         /**
          * @brief Destroy the String object
          */
-        ~String() = default;
+        ~String()
+        {
+            _release();
+        }
 
         /**
          * @brief Copy assignment operator.
@@ -124,11 +383,9 @@ namespace UserDefined
         {
             if (this != &sourceString)
             {
-                _strLength = sourceString._strLength;
-                _strData = std::make_unique<char[]>(_strLength + 1);
-
-                std::copy(sourceString._strData.get(), sourceString._strData.get() + _strLength, _strData.get());
-                _strData[_strLength] = '\0';
+                Instrumentation::recordCopy();
+                _assign(sourceString._strData, sourceString._strLength);
+                _copyHash(sourceString);
             }
             return *this;
         }
@@ -137,64 +394,208 @@ namespace UserDefined
          * @brief Move assignment operator.
          *
          * Replaces the contents of the string by moving the data of another string.
+         * If the strings use different resources, the buffer cannot change hands and
+         * the characters are copied instead.
          *
          * @param sourceString The string to move.
          * @return A reference to the string.
          */
-        String& operator=(String&& sourceString) noexcept
+        String& operator=(String&& sourceString)
         {
             if (this != &sourceString)
             {
-                _strData = std::move(sourceString._strData);
-                _strLength = sourceString._strLength;
-                sourceString._strLength = 0;
+                Instrumentation::recordMove();
+                if (_strResource->isEqual(*sourceString._strResource))
+                {
+                    _release();
+                    _steal(sourceString);
+                }
+                else
+                {
+                    _assign(sourceString._strData, sourceString._strLength);
+                    _copyHash(sourceString);
+                }
             }
             return *this;
         }
 
+        /**
+         * @brief Concatenation assignment operator.
+         *
+         * Replaces the contents of the string with the result of a concatenation expression.
+         * The expression may refer to this string (e.g. `s = s + t`).
+         *
+         * @param expression The concatenation expression to evaluate.
+         * @return A reference to the string.
+         */
+        template <typename Left, typename Right>
+        String& operator=(const StringConcat<Left, Right>& expression)
+        {
+            return *this = String(expression, _strResource);
+        }
+
         // #endregion
 
         // #region Overloaded Operators
 
         /**
-         * @brief Addition (append) operator.
+         * @brief Compound append operator.
          *
-         * Appends another string to the string.
+         * Appends another string to the string in place.
          *
          * @param appendString The string to append.
-         * @return A new string that is the concatenation of the string and the other string.
+         * @return A reference to the string.
          */
-        String operator+(const String& appendString)
+        String& operator+=(const String& appendString)
         {
-            String resultString;
+            return append(appendString);
+        }
 
-            resultString._strLength = _strLength + appendString._strLength;
-            resultString._strData = std::make_unique<char[]>(resultString._strLength + 1);
+        /**
+         * @brief Compound append operator.
+         *
+         * Appends a C-string to the string in place.
+         *
+         * @param appendString The C-string to append.
+         * @return A reference to the string.
+         */
+        String& operator+=(const char* appendString)
+        {
+            return append(appendString);
+        }
 
-            std::copy(_strData.get(), _strData.get() + _strLength, resultString._strData.get());
-            std::copy(appendString._strData.get(), appendString._strData.get() + appendString._strLength, resultString._strData.get() + _strLength);
-            resultString._strData[resultString._strLength] = '\0';
+        /**
+         * @brief Compound append operator.
+         *
+         * Appends the characters of a view (or a FixedString, or a std::string) to the string in place.
+         *
+         * @param appendView The characters to append.
+         * @return A reference to the string.
+         */
+        String& operator+=(StringView appendView)
+        {
+            return append(appendView);
+        }
 
-            return resultString;
+        /**
+         * @brief Compound append operator.
+         *
+         * Appends a single character to the string in place.
+         *
+         * @param ch The character to append.
+         * @return A reference to the string.
+         */
+        String& operator+=(char ch)
+        {
+            push_back(ch);
+            return *this;
         }
 
         /**
          * @brief Comparison operator.
          *
-         * Compares the string to another string for equality.
+         * Compares the string to another string for equality. If both strings have
+         * already cached their hash, differing hashes settle the comparison without
+         * looking at the characters.
          *
          * @param compareString The string to compare to.
          * @return true if the strings are equal, false otherwise.
          */
         bool operator==(const String& compareString) const
         {
-            return _strLength == compareString._strLength && std::equal(_strData.get(), _strData.get() + _strLength, compareString._strData.get());
+            if (_strData == compareString._strData)
+            {
+                return true;
+            }
+            if (_strLength != compareString._strLength)
+            {
+                return false;
+            }
+
+            std::size_t hash = _cachedHash();
+            std::size_t compareHash = compareString._cachedHash();
+            if (hash != 0 && compareHash != 0 && hash != compareHash)
+            {
+                return false;
+            }
+
+            return std::memcmp(_strData, compareString._strData, _strLength) == 0;
+        }
+
+        /**
+         * @brief Ordering operators.
+         *
+         * Compare lexicographically with compare(), so Strings can be keys of std::map and
+         * std::set or be sorted. The right operand may be a String, a StringView or a FixedString.
+         *
+         * @param compareView The characters to compare to.
+         * @return The result of the comparison.
+         */
+        bool operator<(StringView compareView) const { return compare(compareView) < 0; }
+        bool operator<=(StringView compareView) const { return compare(compareView) <= 0; }
+        bool operator>(StringView compareView) const { return compare(compareView) > 0; }
+        bool operator>=(StringView compareView) const { return compare(compareView) >= 0; }
+
+        /**
+         * @brief Conversion operator.
+         *
+         * Gets a view of the whole string. The view is invalidated by any change to the string.
+         *
+         * @return A view of the characters of the string.
+         */
+        operator StringView() const noexcept
+        {
+            return StringView(_strData, _strLength);
         }
 
         // #endregion
 
         // #region Public Methods
 
+        /**
+         * @brief Makes the decimal text of an integer, like std::to_string() but without the locale.
+         *
+         * Every integer fits the inline buffer, so this never allocates.
+         *
+         * @param value The integer.
+         * @return The text, e.g. "-42".
+         */
+        template <typename Integer>
+        static String fromInt(Integer value)
+        {
+            char buffer[maxIntegerLength];
+            return String(StringView(buffer, static_cast<std::size_t>(formatInteger(buffer, value) - buffer)));
+        }
+
+        /**
+         * @brief Makes the shortest text that reads back as the same double; see formatDouble().
+         *
+         * Only negative numbers with 17 digits and a three-digit exponent are longer than the
+         * inline buffer, so this practically never allocates.
+         *
+         * @param value The double.
+         * @return The text, e.g. "0.1" or "1e+100".
+         */
+        static String fromDouble(double value)
+        {
+            char buffer[maxDoubleLength];
+            return String(StringView(buffer, static_cast<std::size_t>(formatDouble(buffer, value) - buffer)));
+        }
+
+        /**
+         * @brief Compares the string to other characters lexicographically, like std::string::compare().
+         *
+         * Characters are compared as unsigned char values and a proper prefix orders first;
+         * see StringView::compare().
+         *
+         * @param compareView The characters to compare to.
+         * @return A negative value if the string orders first, 0 if the characters are equal, a positive value otherwise.
+         */
+        int compare(StringView compareView) const
+        {
+            return StringView(*this).compare(compareView);
+        }
+
         /**
          * @brief Gets the length of the string.
          *
@@ -212,70 +613,1230 @@ namespace UserDefined
          */
         const char* c_str() const
         {
-            return _strData.get();
+            return _strData;
         }
 
-        // #endregion
-
         /**
-         * @brief Inserts the string into an output stream.
+         * @brief Gets the number of characters the string can hold without reallocating.
          *
-         * @param outputStream The output stream.
-         * @param outputString The string to insert.
+         * @return The capacity of the string (not counting the terminating null character).
+         */
+        std::size_t capacity() const
+        {
+            return _isLocal() ? _localCapacity : _strHeap.capacity;
+        }
+
+        /**
+         * @brief Gets the memory resource the heap buffer is allocated from.
          *
-         * @return The output stream.
+         * @return The memory resource of the string.
          */
-        friend std::ostream& operator<<(std::ostream& outputStream, const String& outputString);
+        MemoryResource* memoryResource() const
+        {
+            return _strResource;
+        }
 
         /**
-         * @brief Extracts a string from an input stream.
+         * @brief Gets the hash of the string.
          *
-         * @param inputStream The input stream.
-         * @param inputString The string to extract to.
+         * The hash is computed with hashBytes() on first use and, for heap strings, cached in
+         * the string until it is modified, so repeated lookups of the same key hash it only
+         * once. Inline strings are short enough to hash again on every call. Calling
+         * hash() concurrently on a string that is not being modified is safe.
          *
-         * @return The input stream.
+         * @return The hash of the characters (equal strings have equal hashes).
          */
-        friend std::istream& operator>>(std::istream& inputStream, String& inputString);
-
-    private:
-        std::size_t _strLength;              ///< The length of the string.
-        std::unique_ptr<char[]> _strData;    ///< The string data.
-    };
+        std::size_t hash() const
+        {
+            std::size_t cachedHash = _cachedHash();
+            if (cachedHash == 0)
+            {
+                cachedHash = StringView(*this).hash();
+                if (!_isLocal())
+                {
+                    _strHeap.hash.store(cachedHash, std::memory_order_relaxed);
+                }
+            }
+            return cachedHash;
+        }
 
-    std::ostream& operator<<(std::ostream& outputStream, const String& outputString)
-    {
-        outputStream << outputString.c_str();
-        return outputStream;
-    }
+        /**
+         * @brief Checks whether the string equals other characters, ignoring the case of ASCII letters.
+         *
+         * @param compareView The characters to compare to.
+         * @return true if the characters differ only in the case of ASCII letters.
+         */
+        bool equalsIgnoreCase(StringView compareView) const
+        {
+            return StringView(*this).equalsIgnoreCase(compareView);
+        }
 
-    std::istream& operator>>(std::istream& inputStream, String& inputString)
-    {
-        char ch;
-        std::size_t len = 0;
-        std::size_t capacity = 16;
-        char* buffer = new char[capacity];
+        /**
+         * @brief Gets a hash that ignores the case of ASCII letters; see StringView::hashIgnoreCase().
+         *
+         * Unlike hash(), it is not cached: keys looked up case-insensitively are usually
+         * hashed once, and caching it would make every string larger.
+         *
+         * @return The hash of the lowercased characters (never 0).
+         */
+        std::size_t hashIgnoreCase() const
+        {
+            return StringView(*this).hashIgnoreCase();
+        }
 
-        while (inputStream.get(ch) && ch != '\n')
+        /**
+         * @brief Makes sure the string can hold at least the given number of characters without reallocating.
+         *
+         * @param newCapacity The number of characters to make room for.
+         */
+        void reserve(std::size_t newCapacity)
         {
-            if (len == capacity - 1)
+            if (newCapacity > capacity())
             {
-                capacity *= 2;
-                char* newBuffer = new char[capacity];
-                std::copy(buffer, buffer + len, newBuffer);
-                delete[] buffer;
-                buffer = newBuffer;
+                _reallocate(newCapacity);
             }
-
-            buffer[len] = ch;
-            len++;
         }
 
-        buffer[len] = '\0';
-        inputString._strLength = len;
-        inputString._strData.reset(buffer);
+        /**
+         * @brief Resizes the string and lets an operation write its characters directly, like
+         *        C++23 std::string::resize_and_overwrite().
+         *
+         * The buffer grows to exactly maxLength characters if needed (keeping the current
+         * characters) and is not initialized beyond them, so filling it costs one pass.
+         *
+         * @param maxLength The number of characters the operation may write.
+         * @param operation Called as operation(data, maxLength); returns the final length (at most maxLength).
+         */
+        template <typename Operation>
+        void resize_and_overwrite(std::size_t maxLength, Operation operation)
+        {
+            reserve(maxLength);
+            std::size_t newLength = operation(_strData, maxLength);
+            assert(newLength <= maxLength);
 
-        return inputStream;
-    }
+            _strLength = newLength;
+            _strData[_strLength] = '\0';
+            _invalidateHash();
+        }
+
+        /**
+         * @brief Replaces the contents of the string with a copy of the given characters.
+         *
+         * The existing buffer is reused whenever it is large enough. The characters may be
+         * part of this string.
+         *
+         * @param source The characters to copy.
+         * @return A reference to the string.
+         */
+        String& assign(StringView source)
+        {
+            if (source.length() > capacity())
+            {
+                // Too long to be part of this string.
+                _assign(source.data(), source.length());
+            }
+            else
+            {
+                std::memmove(_strData, source.data(), source.length());
+                _strLength = source.length();
+                _strData[_strLength] = '\0';
+                _invalidateHash();
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Appends characters to the end of the string.
+         *
+         * The capacity grows geometrically, so a sequence of appends runs in amortized linear time.
+         * Appending (part of) the string to itself is allowed.
+         *
+         * @param appendData The characters to append.
+         * @param appendLength The number of characters to append.
+         * @return A reference to the string.
+         */
+        String& append(const char* appendData, std::size_t appendLength)
+        {
+            std::size_t newLength = _strLength + appendLength;
+            _invalidateHash();
+
+            if (newLength > capacity())
+            {
+                // The old buffer is freed only after copying, as appendData may point into it.
+                std::size_t newCapacity = std::max(newLength, 2 * capacity());
+                char* newData = _allocate(newCapacity);
+
+                std::copy(_strData, _strData + _strLength, newData);
+                std::copy(appendData, appendData + appendLength, newData + _strLength);
+
+                _deallocate();
+                _setHeapBuffer(newData, newCapacity);
+            }
+            else
+            {
+                std::copy(appendData, appendData + appendLength, _strData + _strLength);
+            }
+
+            _strLength = newLength;
+            _strData[_strLength] = '\0';
+
+            return *this;
+        }
+
+        /**
+         * @brief Appends another string to the end of the string.
+         *
+         * @param appendString The string to append.
+         * @return A reference to the string.
+         */
+        String& append(const String& appendString)
+        {
+            return append(appendString._strData, appendString._strLength);
+        }
+
+        /**
+         * @brief Appends a C-string to the end of the string.
+         *
+         * @param appendString The C-string to append.
+         * @return A reference to the string.
+         */
+        String& append(const char* appendString)
+        {
+            return append(appendString, std::strlen(appendString));
+        }
+
+        /**
+         * @brief Appends the characters of a view to the end of the string.
+         *
+         * @param appendView The characters to append.
+         * @return A reference to the string.
+         */
+        String& append(StringView appendView)
+        {
+            return append(appendView.data(), appendView.length());
+        }
+
+        /**
+         * @brief Appends a single character to the end of the string.
+         *
+         * @param ch The character to append.
+         */
+        void push_back(char ch)
+        {
+            _invalidateHash();
+            if (_strLength == capacity())
+            {
+                _reallocate(2 * _strLength);
+            }
+
+            _strData[_strLength] = ch;
+            _strLength++;
+            _strData[_strLength] = '\0';
+        }
+
+        /**
+         * @brief Replaces part of the string with other characters, like std::string::replace().
+         *
+         * The rest of the string is shifted in place when the result fits the capacity;
+         * otherwise the result is built in one new buffer (grown geometrically, like append()).
+         * The replacement may be part of this string.
+         *
+         * @param position The first character to replace; must not exceed length().
+         * @param count The number of characters to replace (clamped to the end of the string).
+         * @param replacement The characters to put in their place.
+         * @return A reference to the string.
+         */
+        String& replace(std::size_t position, std::size_t count, StringView replacement)
+        {
+            assert(position <= _strLength);
+            if (_overlaps(replacement))
+            {
+                String replacementCopy(replacement);
+                return replace(position, count, StringView(replacementCopy));
+            }
+
+            count = std::min(count, _strLength - position);
+            std::size_t tailLength = _strLength - position - count;
+            std::size_t newLength = _strLength - count + replacement.length();
+            _invalidateHash();
+
+            if (newLength > capacity())
+            {
+                std::size_t newCapacity = std::max(newLength, 2 * capacity());
+                char* newData = _allocate(newCapacity);
+
+                std::copy(_strData, _strData + position, newData);
+                std::copy(replacement.begin(), replacement.end(), newData + position);
+                std::copy(_strData + position + count, _strData + _strLength + 1, newData + position + replacement.length());
+
+                _deallocate();
+                _setHeapBuffer(newData, newCapacity);
+            }
+            else
+            {
+                std::memmove(_strData + position + replacement.length(), _strData + position + count, tailLength + 1);
+                std::copy(replacement.begin(), replacement.end(), _strData + position);
+            }
+
+            _strLength = newLength;
+            return *this;
+        }
+
+        /**
+         * @brief Replaces every occurrence of a substring, scanning the string once per pass.
+         *
+         * Occurrences are found left to right with the vectorized substring search and do not
+         * overlap (replacing "aa" in "aaa" replaces the first two characters). A replacement no
+         * longer than the needle is written in place in a single pass, compacting the string as
+         * it goes, with no allocation. A longer one first counts the occurrences to compute the
+         * final length, then builds the result in one exactly sized buffer. The needle and the
+         * replacement may be part of this string.
+         *
+         * @param needle The substring to replace; an empty needle replaces nothing.
+         * @param replacement The characters to put in its place.
+         * @return The number of occurrences replaced.
+         */
+        std::size_t replace_all(StringView needle, StringView replacement)
+        {
+            if (needle.empty())
+            {
+                return 0;
+            }
+            if (_overlaps(needle) || _overlaps(replacement))
+            {
+                String needleCopy(needle);
+                String replacementCopy(replacement);
+                return replace_all(StringView(needleCopy), StringView(replacementCopy));
+            }
+
+            if (replacement.length() <= needle.length())
+            {
+                return _replaceAllInPlace(needle, replacement);
+            }
+
+            std::size_t occurrences = StringView(*this).count(needle);
+            if (occurrences == 0)
+            {
+                return 0;
+            }
+
+            std::size_t newLength = _strLength + occurrences * (replacement.length() - needle.length());
+            _invalidateHash();
+            if (newLength <= capacity())
+            {
+                // The result fits the buffer: move the text to its end, then rebuild the string from the
+                // front. The write position stays at or before the read position, so the text still to be
+                // searched is never overwritten, and the occurrences are the ones a left-to-right search finds.
+                char* text = _strData + (newLength - _strLength);
+                std::memmove(text, _strData, _strLength);
+                _replaceAllInto(_strData, StringView(text, _strLength), needle, replacement);
+            }
+            else
+            {
+                char* newData = _allocate(newLength);
+                _replaceAllInto(newData, StringView(_strData, _strLength), needle, replacement);
+                _deallocate();
+                _setHeapBuffer(newData, newLength);
+            }
+
+            _strLength = newLength;
+            return occurrences;
+        }
+
+        /**
+         * @brief Converts the ASCII letters of the string to lowercase in place, 16 or 32 characters at a time.
+         *
+         * Other bytes, including UTF-8 sequences, are left unchanged; use toLower(StringView)
+         * for a lowercased copy.
+         *
+         * @return A reference to this string.
+         */
+        String& toLower()
+        {
+            Simd::toLower(_strData, _strData, _strLength);
+            _invalidateHash();
+            return *this;
+        }
+
+        /**
+         * @brief Converts the ASCII letters of the string to uppercase in place, 16 or 32 characters at a time.
+         *
+         * Other bytes, including UTF-8 sequences, are left unchanged; use toUpper(StringView)
+         * for an uppercased copy.
+         *
+         * @return A reference to this string.
+         */
+        String& toUpper()
+        {
+            Simd::toUpper(_strData, _strData, _strLength);
+            _invalidateHash();
+            return *this;
+        }
+
+        /**
+         * @brief Finds the first occurrence of a character.
+         *
+         * Like all search functions, this runs a vectorized kernel (see Simd.hpp).
+         *
+         * @param ch The character to find.
+         * @param position The position to start searching at.
+         * @return The position of the character, or npos if it is not found.
+         */
+        std::size_t find(char ch, std::size_t position = 0) const
+        {
+            return StringView(*this).find(ch, position);
+        }
+
+        /**
+         * @brief Finds the first occurrence of a substring.
+         *
+         * @param needleData The characters of the substring.
+         * @param position The position to start searching at.
+         * @param needleLength The length of the substring.
+         * @return The position of the substring, or npos if it is not found.
+         */
+        std::size_t find(const char* needleData, std::size_t position, std::size_t needleLength) const
+        {
+            return StringView(*this).find(StringView(needleData, needleLength), position);
+        }
+
+        /**
+         * @brief Finds the first occurrence of a string (a String, C-string or view).
+         *
+         * @param needle The string to find.
+         * @param position The position to start searching at.
+         * @return The position of the string, or npos if it is not found.
+         */
+        std::size_t find(StringView needle, std::size_t position = 0) const
+        {
+            return StringView(*this).find(needle, position);
+        }
+
+        /**
+         * @brief Finds the last occurrence of a character.
+         *
+         * @param ch The character to find.
+         * @param position The last position to consider (npos for the whole string).
+         * @return The position of the character, or npos if it is not found.
+         */
+        std::size_t rfind(char ch, std::size_t position = npos) const
+        {
+            return StringView(*this).rfind(ch, position);
+        }
+
+        /**
+         * @brief Finds the last occurrence of a substring.
+         *
+         * @param needleData The characters of the substring.
+         * @param position The last starting position to consider (npos for the whole string).
+         * @param needleLength The length of the substring.
+         * @return The position of the substring, or npos if it is not found.
+         */
+        std::size_t rfind(const char* needleData, std::size_t position, std::size_t needleLength) const
+        {
+            return StringView(*this).rfind(StringView(needleData, needleLength), position);
+        }
+
+        /**
+         * @brief Finds the last occurrence of a string (a String, C-string or view).
+         *
+         * @param needle The string to find.
+         * @param position The last starting position to consider (npos for the whole string).
+         * @return The position of the string, or npos if it is not found.
+         */
+        std::size_t rfind(StringView needle, std::size_t position = npos) const
+        {
+            return StringView(*this).rfind(needle, position);
+        }
+
+        /**
+         * @brief Finds the first character that is one of the given characters.
+         *
+         * @param setData The characters to look for.
+         * @param position The position to start searching at.
+         * @param setLength The number of characters to look for.
+         * @return The position of the first matching character, or npos if there is none.
+         */
+        std::size_t find_first_of(const char* setData, std::size_t position, std::size_t setLength) const
+        {
+            return StringView(*this).find_first_of(StringView(setData, setLength), position);
+        }
+
+        /**
+         * @brief Finds the first character that is one of the characters of a string (a String, C-string or view).
+         *
+         * @param set The characters to look for.
+         * @param position The position to start searching at.
+         * @return The position of the first matching character, or npos if there is none.
+         */
+        std::size_t find_first_of(StringView set, std::size_t position = 0) const
+        {
+            return StringView(*this).find_first_of(set, position);
+        }
+
+        /**
+         * @brief Counts the occurrences of a character.
+         *
+         * @param ch The character to count.
+         * @return The number of occurrences.
+         */
+        std::size_t count(char ch) const
+        {
+            return StringView(*this).count(ch);
+        }
+
+        /**
+         * @brief Removes all characters from the string. The capacity is kept.
+         */
+        void clear()
+        {
+            _invalidateHash();
+            _strLength = 0;
+            _strData[0] = '\0';
+        }
+
+        /**
+         * @brief Releases unused capacity, moving the string back inline if it is short enough.
+         */
+        void shrink_to_fit()
+        {
+            if (!_isLocal() && _strHeap.capacity > _strLength)
+            {
+                _reallocate(_strLength);
+            }
+        }
+
+        /**
+         * @brief Gives the buffer away, leaving the string empty.
+         *
+         * A heap buffer from a new/delete resource changes hands without copying. Short
+         * strings, which have no heap buffer, and strings from other resources (such as an
+         * arena) are copied into a new buffer of exactly their length.
+         *
+         * @return The buffer, its length and its capacity; pass it to String(OwnedBuffer&&) to adopt it again.
+         */
+        OwnedBuffer release()
+        {
+            OwnedBuffer buffer;
+            buffer.length = _strLength;
+            if (!_isLocal() && _strResource->isEqual(*newDeleteResource()))
+            {
+                Instrumentation::recordDeallocation(_strHeap.capacity + 1);
+                buffer.data.reset(_strData);
+                buffer.capacity = _strHeap.capacity;
+                _strData = _localBuffer;
+            }
+            else
+            {
+                // The copy is allocated on the string's behalf and leaves it at once, like a released heap buffer.
+                buffer.data.reset(new char[_strLength + 1]);
+                Instrumentation::recordAllocation(_strLength + 1);
+                Instrumentation::recordDeallocation(_strLength + 1);
+                std::copy(_strData, _strData + _strLength + 1, buffer.data.get());
+                buffer.capacity = _strLength;
+            }
+
+            _release();
+            return buffer;
+        }
+
+        /**
+         * @brief Exchanges the contents of two strings.
+         *
+         * With equal resources the objects trade their bytes and no character is copied, which
+         * is what std::sort and other algorithms that swap elements rely on. Otherwise the
+         * contents are exchanged by copying and each string keeps its resource.
+         *
+         * @param otherString The string to swap with.
+         */
+        void swap(String& otherString)
+        {
+            if (this == &otherString)
+            {
+                return;
+            }
+            if (!_strResource->isEqual(*otherString._strResource))
+            {
+                String temporary(std::move(otherString));
+                otherString = std::move(*this);
+                *this = std::move(temporary);
+                return;
+            }
+
+            char* heapData = _isLocal() ? nullptr : _strData;
+            char* otherHeapData = otherString._isLocal() ? nullptr : otherString._strData;
+            char storage[sizeof(_localBuffer)];
+            std::memcpy(storage, _localBuffer, sizeof(storage));
+            std::memcpy(_localBuffer, otherString._localBuffer, sizeof(storage));
+            std::memcpy(otherString._localBuffer, storage, sizeof(storage));
+            _strData = otherHeapData ? otherHeapData : _localBuffer;
+            otherString._strData = heapData ? heapData : otherString._localBuffer;
+
+            std::swap(_strLength, otherString._strLength);
+        }
+
+        // #endregion
+
+        /**
+         * @brief Inserts the string into an output stream.
+         *
+         * Writes length() characters in one write(), including any null characters.
+         *
+         * @param outputStream The output stream.
+         * @param outputString The string to insert.
+         *
+         * @return The output stream.
+         */
+        friend std::ostream& operator<<(std::ostream& outputStream, const String& outputString);
+
+        /**
+         * @brief Extracts a line from an input stream.
+         *
+         * Reads up to the next newline, which is consumed but not stored, reusing the
+         * capacity the string already has. For bulk input, LineReader is faster still.
+         *
+         * @param inputStream The input stream.
+         * @param inputString The string to extract to.
+         *
+         * @return The input stream.
+         */
+        friend std::istream& operator>>(std::istream& inputStream, String& inputString);
+
+    private:
+        static constexpr std::size_t _localCapacity = 23;    ///< Longest string stored without a heap allocation.
+
+        /**
+         * @brief The state of a heap string, kept in the bytes of the inline buffer it does not use.
+         */
+        struct HeapState
+        {
+            std::size_t capacity;                        ///< The capacity of the heap buffer.
+            mutable std::atomic<std::size_t> hash;       ///< The cached hash, or 0 if not computed yet.
+        };
+
+        // #region Private Methods
+
+        /**
+         * @brief Checks whether the string currently lives in the inline buffer.
+         *
+         * @return true if the data is stored inline, false if it is on the heap.
+         */
+        bool _isLocal() const
+        {
+            return _strData == _localBuffer;
+        }
+
+        /**
+         * @brief Allocates a heap buffer from the memory resource.
+         *
+         * @param bufferCapacity The number of characters the buffer must hold (the null character is added).
+         * @return The new buffer.
+         */
+        char* _allocate(std::size_t bufferCapacity)
+        {
+            char* buffer = static_cast<char*>(_strResource->allocate(bufferCapacity + 1, alignof(char)));
+            Instrumentation::recordAllocation(bufferCapacity + 1);
+            return buffer;
+        }
+
+        /**
+         * @brief Returns a heap buffer to the memory resource.
+         *
+         * @param buffer The buffer to free.
+         * @param bufferCapacity The capacity it was allocated with.
+         */
+        void _deallocate(char* buffer, std::size_t bufferCapacity) noexcept
+        {
+            Instrumentation::recordDeallocation(bufferCapacity + 1);
+            _strResource->deallocate(buffer, bufferCapacity + 1, alignof(char));
+        }
+
+        /**
+         * @brief Frees the heap buffer, if any. The string is left dangling and must be reset by the caller.
+         */
+        void _deallocate() noexcept
+        {
+            if (!_isLocal())
+            {
+                _deallocate(_strData, _strHeap.capacity);
+            }
+        }
+
+        /**
+         * @brief Frees the heap buffer (if any) and resets to an empty inline string.
+         */
+        void _release() noexcept
+        {
+            _deallocate();
+            _invalidateHash();
+
+            _strLength = 0;
+            _strData = _localBuffer;
+            _localBuffer[0] = '\0';
+        }
+
+        /**
+         * @brief Moves the contents into storage of exactly the given capacity.
+         *
+         * Capacities that fit the inline buffer move the string back inline.
+         *
+         * @param newCapacity The new capacity; must not be less than the length.
+         */
+        void _reallocate(std::size_t newCapacity)
+        {
+            if (newCapacity <= _localCapacity)
+            {
+                if (!_isLocal())
+                {
+                    char* oldData = _strData;
+                    std::size_t oldCapacity = _strHeap.capacity;
+                    std::copy(oldData, oldData + _strLength + 1, _localBuffer);
+                    _deallocate(oldData, oldCapacity);
+                    _strData = _localBuffer;
+                }
+                return;
+            }
+
+            char* newData = _allocate(newCapacity);
+            std::copy(_strData, _strData + _strLength + 1, newData);
+
+            _deallocate();
+            _setHeapBuffer(newData, newCapacity);
+        }
+
+        /**
+         * @brief Makes room for a string of the given length, discarding the current contents.
+         *
+         * The existing buffer (inline or heap) is reused whenever it is large enough.
+         * The terminating null character is written; the caller fills in the characters.
+         *
+         * @param length The length of the new string.
+         * @return A pointer to the (uninitialized) characters of the string.
+         */
+        char* _prepare(std::size_t length)
+        {
+            if (length > capacity())
+            {
+                char* newData = _allocate(length);
+
+                _deallocate();
+                _setHeapBuffer(newData, length);
+            }
+
+            _strLength = length;
+            _strData[_strLength] = '\0';
+            _invalidateHash();
+
+            return _strData;
+        }
+
+        /**
+         * @brief Replaces the contents of the string with a copy of the given characters.
+         *
+         * @param source The characters to copy (must not point into this string).
+         * @param length The number of characters to copy.
+         */
+        void _assign(const char* source, std::size_t length)
+        {
+            std::copy(source, source + length, _prepare(length));
+        }
+
+        /**
+         * @brief Takes over the data of another string and leaves it empty.
+         *
+         * The current string must not own a heap buffer (call _release() first), and
+         * both strings must use equal resources.
+         *
+         * @param sourceString The string to take the data from.
+         */
+        void _steal(String& sourceString) noexcept
+        {
+            // The inline buffer and the heap state share their bytes: copying them all takes either, without a loop.
+            std::memcpy(_localBuffer, sourceString._localBuffer, sizeof(_localBuffer));
+            _strData = sourceString._isLocal() ? _localBuffer : sourceString._strData;
+
+            _strLength = sourceString._strLength;
+            sourceString._strLength = 0;
+            sourceString._strData = sourceString._localBuffer;
+            sourceString._localBuffer[0] = '\0';
+        }
+
+        /**
+         * @brief Checks whether characters lie inside the buffer of this string.
+         *
+         * @param view The characters.
+         * @return true if they would be overwritten by changing the string in place.
+         */
+        bool _overlaps(StringView view) const
+        {
+            std::less_equal<const char*> lessEqual;
+            return !view.empty() && lessEqual(_strData, view.data()) && lessEqual(view.data(), _strData + _strLength);
+        }
+
+        /**
+         * @brief Replaces every occurrence of a needle in place; the replacement must not be longer.
+         *
+         * The write position never passes the read position, so the part still to be searched
+         * is never overwritten.
+         *
+         * @return The number of occurrences replaced.
+         */
+        std::size_t _replaceAllInPlace(StringView needle, StringView replacement)
+        {
+            StringView text(_strData, _strLength);
+            std::size_t occurrences = 0;
+            std::size_t read = 0;
+            std::size_t write = 0;
+
+            for (std::size_t found = text.find(needle); found != npos; found = text.find(needle, read))
+            {
+                if (write != read)
+                {
+                    std::memmove(_strData + write, _strData + read, found - read);
+                }
+                write += found - read;
+                std::copy(replacement.begin(), replacement.end(), _strData + write);
+                write += replacement.length();
+                read = found + needle.length();
+                occurrences++;
+            }
+
+            if (occurrences != 0)
+            {
+                std::memmove(_strData + write, _strData + read, _strLength - read + 1);
+                _strLength = write + _strLength - read;
+                _invalidateHash();
+            }
+            return occurrences;
+        }
+
+        /**
+         * @brief Writes text with every occurrence of a needle replaced, followed by a null character.
+         *
+         * @param output The buffer; it must hold the result and its null character. It may overlap the
+         *               text if it starts at or before it.
+         * @param text The text to search.
+         */
+        static void _replaceAllInto(char* output, StringView text, StringView needle, StringView replacement)
+        {
+            std::size_t read = 0;
+
+            for (std::size_t found = text.find(needle); found != npos; found = text.find(needle, read))
+            {
+                output = std::copy(text.data() + read, text.data() + found, output);
+                output = std::copy(replacement.begin(), replacement.end(), output);
+                read = found + needle.length();
+            }
+            output = std::copy(text.data() + read, text.data() + text.length(), output);
+            *output = '\0';
+        }
+
+        /**
+         * @brief Forgets the cached hash. Called by every function that changes the characters.
+         */
+        void _invalidateHash() noexcept
+        {
+            if (!_isLocal())
+            {
+                _strHeap.hash.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Takes over the cached hash of a string with the same characters.
+         *
+         * @param sourceString The string the characters were copied or moved from.
+         */
+        void _copyHash(const String& sourceString) noexcept
+        {
+            if (!_isLocal())
+            {
+                _strHeap.hash.store(sourceString._cachedHash(), std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Gets the cached hash. Inline strings do not cache it, as they are quick to hash.
+         *
+         * @return The cached hash, or 0 if it is not known.
+         */
+        std::size_t _cachedHash() const noexcept
+        {
+            return _isLocal() ? 0 : _strHeap.hash.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Switches to a heap buffer, which has no cached hash yet.
+         *
+         * @param buffer The heap buffer; the string owns it from now on.
+         * @param bufferCapacity The number of characters the buffer can hold.
+         */
+        void _setHeapBuffer(char* buffer, std::size_t bufferCapacity) noexcept
+        {
+            _strData = buffer;
+            _strHeap.capacity = bufferCapacity;
+            _strHeap.hash.store(0, std::memory_order_relaxed);
+        }
+
+        // #endregion
+
+        std::size_t _strLength;                      ///< The length of the string.
+        char* _strData;                              ///< The string data (points to _localBuffer for short strings).
+        MemoryResource* _strResource;                ///< The resource heap buffers are allocated from.
+        union
+        {
+            HeapState _strHeap;                      ///< The capacity and cached hash of the heap buffer (when not local).
+            char _localBuffer[_localCapacity + 1];   ///< Inline storage for short strings.
+        };
+    };
+
+    static_assert(sizeof(String) == 3 * sizeof(void*) + 24, "String should be three pointers and the inline buffer");
+
+    namespace Detail
+    {
+        /**
+         * @brief Maps the type of an operator+ operand to its node in a concatenation expression.
+         *
+         * Only the specialized types can take part in a concatenation.
+         *
+         * @tparam T The (decayed) type of the operand.
+         */
+        template <typename T>
+        struct ConcatOperand;
+
+        template <>
+        struct ConcatOperand<String>
+        {
+            using type = StringPiece;
+            static type make(const String& operand) { return StringPiece(operand.c_str(), operand.length()); }
+        };
+
+        template <>
+        struct ConcatOperand<const char*>
+        {
+            using type = StringPiece;
+            static type make(const char* operand) { return StringPiece(operand, std::strlen(operand)); }
+        };
+
+        template <>
+        struct ConcatOperand<char*> : ConcatOperand<const char*>
+        {
+        };
+
+        template <>
+        struct ConcatOperand<StringView>
+        {
+            using type = StringPiece;
+            static type make(StringView operand) { return StringPiece(operand.data(), operand.length()); }
+        };
+
+        template <>
+        struct ConcatOperand<std::string>
+        {
+            using type = StringPiece;
+            static type make(const std::string& operand) { return StringPiece(operand.data(), operand.size()); }
+        };
+
+        template <std::size_t Capacity>
+        struct ConcatOperand<FixedString<Capacity>>
+        {
+            using type = StringPiece;
+            static type make(const FixedString<Capacity>& operand) { return StringPiece(operand.data(), operand.length()); }
+        };
+
+        template <typename Left, typename Right>
+        struct ConcatOperand<StringConcat<Left, Right>>
+        {
+            using type = StringConcat<Left, Right>;
+            static const type& make(const type& operand) { return operand; }
+        };
+
+        /**
+         * @brief Checks whether a type is a String, a StringView, a FixedString or a concatenation expression.
+         *
+         * At least one operand of operator+ must be, so that e.g. `const char* + std::string` is left alone.
+         */
+        template <typename T>
+        struct IsStringExpression : std::false_type
+        {
+        };
+
+        template <>
+        struct IsStringExpression<String> : std::true_type
+        {
+        };
+
+        template <>
+        struct IsStringExpression<StringView> : std::true_type
+        {
+        };
+
+        template <std::size_t Capacity>
+        struct IsStringExpression<FixedString<Capacity>> : std::true_type
+        {
+        };
+
+        template <typename Left, typename Right>
+        struct IsStringExpression<StringConcat<Left, Right>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        using ConcatOperandOf = ConcatOperand<typename std::decay<T>::type>;
+
+        /**
+         * @brief Checks whether a type owns its characters, so that a temporary of it dies with the full-expression.
+         */
+        template <typename T>
+        struct IsOwningString : std::false_type
+        {
+        };
+
+        template <>
+        struct IsOwningString<String> : std::true_type
+        {
+        };
+
+        template <>
+        struct IsOwningString<std::string> : std::true_type
+        {
+        };
+
+        template <std::size_t Capacity>
+        struct IsOwningString<FixedString<Capacity>> : std::true_type
+        {
+        };
+
+        /**
+         * @brief Gets the type returned by operator+ for operands forwarded as Left and Right.
+         *
+         * The result is a lazy expression, unless an operand is a temporary that owns its
+         * characters: the expression would then outlive them, so it is materialized at once.
+         */
+        template <typename Left, typename Right>
+        struct ConcatResult
+        {
+            using expression = StringConcat<typename ConcatOperandOf<Left>::type, typename ConcatOperandOf<Right>::type>;
+
+            static constexpr bool borrowsTemporary =
+                (!std::is_lvalue_reference<Left>::value && IsOwningString<typename std::decay<Left>::type>::value) ||
+                (!std::is_lvalue_reference<Right>::value && IsOwningString<typename std::decay<Right>::type>::value);
+
+            using type = typename std::conditional<borrowsTemporary, String, expression>::type;
+        };
+    }
+
+    /**
+     * @brief Addition (concatenation) operator.
+     *
+     * Builds a lazy concatenation expression instead of a temporary String, so that a chain such as
+     * `a + b + c + d` allocates and copies only once, when the result is assigned to a String.
+     * Operands may be Strings, StringViews, C-strings, std::strings or other concatenation expressions.
+     * When an operand is a temporary String, std::string or FixedString, the result is a String
+     * instead, since an expression borrowing from it would dangle once the statement ends.
+     *
+     * @param left The left operand.
+     * @param right The right operand.
+     * @return An expression representing the concatenation of both operands, or the concatenated String.
+     */
+    template <typename Left, typename Right,
+              typename = typename std::enable_if<Detail::IsStringExpression<typename std::decay<Left>::type>::value ||
+                                                 Detail::IsStringExpression<typename std::decay<Right>::type>::value>::type>
+    typename Detail::ConcatResult<Left, Right>::type operator+(Left&& left, Right&& right)
+    {
+        return typename Detail::ConcatResult<Left, Right>::expression(Detail::ConcatOperandOf<Left>::make(left),
+                                                                      Detail::ConcatOperandOf<Right>::make(right));
+    }
+
+    /**
+     * @brief Equality operators between a concatenation expression and other characters.
+     *
+     * They compare the characters of each operand in place, without materializing the expression.
+     *
+     * @param left The left operand.
+     * @param right The right operand.
+     * @return The result of the comparison.
+     */
+    template <typename Left, typename Right, typename Text,
+              typename = typename std::enable_if<std::is_convertible<const Text&, StringView>::value>::type>
+    bool operator==(const StringConcat<Left, Right>& left, const Text& right)
+    {
+        StringView characters(right);
+        return left.length() == characters.length() && left.matches(characters.data());
+    }
+
+    template <typename Left, typename Right, typename Text,
+              typename = typename std::enable_if<std::is_convertible<const Text&, StringView>::value>::type>
+    bool operator==(const Text& left, const StringConcat<Left, Right>& right) { return right == left; }
+
+    template <typename Left, typename Right, typename Text,
+              typename = typename std::enable_if<std::is_convertible<const Text&, StringView>::value>::type>
+    bool operator!=(const StringConcat<Left, Right>& left, const Text& right) { return !(left == right); }
+
+    template <typename Left, typename Right, typename Text,
+              typename = typename std::enable_if<std::is_convertible<const Text&, StringView>::value>::type>
+    bool operator!=(const Text& left, const StringConcat<Left, Right>& right) { return !(right == left); }
+
+    template <typename LeftA, typename RightA, typename LeftB, typename RightB>
+    bool operator==(const StringConcat<LeftA, RightA>& left, const StringConcat<LeftB, RightB>& right)
+    {
+        return left.length() == right.length() && left == String(right);
+    }
+
+    template <typename LeftA, typename RightA, typename LeftB, typename RightB>
+    bool operator!=(const StringConcat<LeftA, RightA>& left, const StringConcat<LeftB, RightB>& right) { return !(left == right); }
+
+    inline std::ostream& operator<<(std::ostream& outputStream, const String& outputString)
+    {
+        return outputStream << StringView(outputString);
+    }
+
+    inline std::istream& operator>>(std::istream& inputStream, String& inputString)
+    {
+        // Read straight into the existing buffer, in chunks as large as its free capacity.
+        // istream::getline() scans the stream buffer in bulk instead of extracting one
+        // character at a time, and the buffer only grows when a line does not fit.
+        std::size_t len = 0;
+        inputString._invalidateHash();
+
+        for (;;)
+        {
+            std::size_t capacity = inputString.capacity();
+            if (len == capacity)
+            {
+                inputString._strLength = len;
+                inputString._reallocate(2 * capacity);
+                capacity = inputString.capacity();
+            }
+
+            inputStream.getline(inputString._strData + len, static_cast<std::streamsize>(capacity - len + 1));
+            std::size_t extracted = static_cast<std::size_t>(inputStream.gcount());
+
+            if (!inputStream.fail())
+            {
+                // Either the newline was found (it is counted, but not stored) or the input ended.
+                len += inputStream.eof() ? extracted : extracted - 1;
+                break;
+            }
+            if (inputStream.eof() || extracted == 0)
+            {
+                break;
+            }
+
+            // The buffer filled up before the end of the line: grow it and continue.
+            len += extracted;
+            inputStream.clear(inputStream.rdstate() & ~std::ios_base::failbit);
+        }
+
+        inputString._strLength = len;
+        inputString._strData[len] = '\0';
+
+        return inputStream;
+    }
+
+    /**
+     * @brief Exchanges the contents of two strings; found by std::swap-using algorithms through ADL.
+     *
+     * @param first The first string.
+     * @param second The second string.
+     */
+    inline void swap(String& first, String& second)
+    {
+        first.swap(second);
+    }
+
+    /**
+     * @brief Equality operators between a String and other characters.
+     *
+     * They compare the lengths, then the characters with memcmp(), without building a
+     * String from the other operand. The String operand is a template parameter so that a
+     * C-string compared with a StringView does not also match these through String's
+     * converting constructor; the overloads for C-strings and FixedStrings keep those
+     * comparisons from being ambiguous between String and StringView.
+     *
+     * @param left The left operand.
+     * @param right The right operand.
+     * @return The result of the comparison.
+     */
+    template <typename Text, typename = typename std::enable_if<std::is_same<Text, String>::value>::type>
+    bool operator==(const Text& left, StringView right)
+    {
+        return left.length() == right.length() && (right.length() == 0 || std::memcmp(left.c_str(), right.data(), right.length()) == 0);
+    }
+
+    template <typename Text, typename = typename std::enable_if<std::is_same<Text, String>::value>::type>
+    bool operator==(StringView left, const Text& right) { return right == left; }
+
+    template <typename Text, typename = typename std::enable_if<std::is_same<Text, String>::value>::type>
+    bool operator!=(const Text& left, StringView right) { return !(left == right); }
+
+    template <typename Text, typename = typename std::enable_if<std::is_same<Text, String>::value>::type>
+    bool operator!=(StringView left, const Text& right) { return !(right == left); }
+
+    inline bool operator==(const String& left, const char* right) { return left == StringView(right); }
+    inline bool operator==(const char* left, const String& right) { return right == StringView(left); }
+    inline bool operator!=(const String& left, const String& right) { return !(left == right); }
+    inline bool operator!=(const String& left, const char* right) { return !(left == StringView(right)); }
+    inline bool operator!=(const char* left, const String& right) { return !(right == StringView(left)); }
+
+    template <std::size_t Capacity>
+    bool operator==(const FixedString<Capacity>& left, const String& right) { return right == StringView(left); }
+
+    template <std::size_t Capacity>
+    bool operator==(const String& left, const FixedString<Capacity>& right) { return left == StringView(right); }
+
+    template <std::size_t Capacity>
+    bool operator!=(const FixedString<Capacity>& left, const String& right) { return !(right == StringView(left)); }
+
+    template <std::size_t Capacity>
+    bool operator!=(const String& left, const FixedString<Capacity>& right) { return !(left == StringView(right)); }
+
+    /**
+     * @brief Makes a copy of characters with the ASCII letters lowercased, converting while copying.
+     *
+     * @param text The characters to convert.
+     * @return The lowercased string.
+     */
+    inline String toLower(StringView text)
+    {
+        String lowered;
+        lowered.resize_and_overwrite(text.length(), [text](char* output, std::size_t length) {
+            Simd::toLower(text.data(), output, length);
+            return length;
+        });
+        return lowered;
+    }
+
+    /**
+     * @brief Makes a copy of characters with the ASCII letters uppercased, converting while copying.
+     *
+     * @param text The characters to convert.
+     * @return The uppercased string.
+     */
+    inline String toUpper(StringView text)
+    {
+        String uppered;
+        uppered.resize_and_overwrite(text.length(), [text](char* output, std::size_t length) {
+            Simd::toUpper(text.data(), output, length);
+            return length;
+        });
+        return uppered;
+    }
+}
+
+namespace std
+{
+    /**
+     * @brief Hash specialization returning the cached hash of a string, so Strings can be unordered_map keys.
+     */
+    template <>
+    struct hash<UserDefined::String>
+    {
+        std::size_t operator()(const UserDefined::String& hashString) const noexcept
+        {
+            return hashString.hash();
+        }
+    };
 }
 
 #endif // STRING_HPP
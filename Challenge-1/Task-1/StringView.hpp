@@ -0,0 +1,528 @@
+/**************************************************************************************************
+ * @file StringView.hpp
+ *
+ * @brief A non-owning view of a run of characters.
+ *
+ * This file contains the definition of StringView, a C++14 counterpart of
+ * std::string_view: a pointer and a length referring to characters owned by
+ * someone else (a String, a C-string, an input buffer). Slicing a view with
+ * substr() or remove_prefix() never copies or allocates, so parsers can cut an
+ * input buffer into fields and only materialize the Strings they keep.
+ *
+ **************************************************************************************************/
+
+#ifndef STRING_VIEW_HPP
+#define STRING_VIEW_HPP
+
+#include "Hash.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace UserDefined
+{
+    /**
+     * @class StringView
+     * @brief A borrowed, read-only run of characters.
+     *
+     * The characters are not owned and not necessarily null-terminated; the view is
+     * only valid as long as the storage it refers to. Views are cheap to copy and
+     * should be passed by value. Strings convert to views implicitly, so functions
+     * taking a StringView accept Strings, C-strings and std::strings alike.
+     */
+    class StringView
+    {
+    public:
+        /// Returned by the search functions when nothing is found.
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        // #region Constructors
+
+        /**
+         * @brief Default constructor.
+         *
+         * Constructs an empty view.
+         */
+        constexpr StringView() noexcept
+            : _viewData("")
+            , _viewLength(0)
+        {
+        }
+
+        /**
+         * @brief Constructs a view of the given characters.
+         *
+         * @param viewData The first character of the view.
+         * @param viewLength The number of characters in the view.
+         */
+        constexpr StringView(const char* viewData, std::size_t viewLength) noexcept
+            : _viewData(viewData)
+            , _viewLength(viewLength)
+        {
+        }
+
+        /**
+         * @brief Constructs a view of a C-string, not including the null character.
+         *
+         * @param inputString The C-string to view.
+         */
+        StringView(const char* inputString) noexcept
+            : _viewData(inputString)
+            , _viewLength(std::strlen(inputString))
+        {
+        }
+
+        /**
+         * @brief Constructs a view of a std::string.
+         *
+         * @param inputString The std::string to view.
+         */
+        StringView(const std::string& inputString) noexcept
+            : _viewData(inputString.data())
+            , _viewLength(inputString.size())
+        {
+        }
+
+        // #endregion
+
+        // #region Overloaded Operators
+
+        /**
+         * @brief Gets a character of the view.
+         *
+         * @param index The position of the character; must be less than length().
+         * @return The character.
+         */
+        constexpr char operator[](std::size_t index) const
+        {
+            return _viewData[index];
+        }
+
+        bool operator==(StringView compareView) const
+        {
+            return _viewLength == compareView._viewLength && std::memcmp(_viewData, compareView._viewData, _viewLength) == 0;
+        }
+
+        bool operator!=(StringView compareView) const
+        {
+            return !(*this == compareView);
+        }
+
+        bool operator<(StringView compareView) const { return compare(compareView) < 0; }
+        bool operator<=(StringView compareView) const { return compare(compareView) <= 0; }
+        bool operator>(StringView compareView) const { return compare(compareView) > 0; }
+        bool operator>=(StringView compareView) const { return compare(compareView) >= 0; }
+
+        // #endregion
+
+        // #region Public Methods
+
+        /**
+         * @brief Gets the characters of the view. They are not necessarily null-terminated.
+         *
+         * @return A pointer to the first character of the view.
+         */
+        constexpr const char* data() const
+        {
+            return _viewData;
+        }
+
+        /**
+         * @brief Gets the number of characters in the view.
+         *
+         * @return The length of the view.
+         */
+        constexpr std::size_t length() const
+        {
+            return _viewLength;
+        }
+
+        /**
+         * @brief Checks whether the view has no characters.
+         *
+         * @return true if the view is empty, false otherwise.
+         */
+        constexpr bool empty() const
+        {
+            return _viewLength == 0;
+        }
+
+        const char* begin() const { return _viewData; }
+        const char* end() const { return _viewData + _viewLength; }
+
+        /**
+         * @brief Gets a view of part of the view, without copying.
+         *
+         * @param position The position of the first character; must not exceed length().
+         * @param count The maximum number of characters (npos for the rest of the view).
+         * @return The view of the characters.
+         */
+        StringView substr(std::size_t position, std::size_t count = npos) const
+        {
+            assert(position <= _viewLength);
+            return StringView(_viewData + position, std::min(count, _viewLength - position));
+        }
+
+        /**
+         * @brief Drops characters from the front of the view.
+         *
+         * @param count The number of characters to drop; must not exceed length().
+         */
+        void remove_prefix(std::size_t count)
+        {
+            assert(count <= _viewLength);
+            _viewData += count;
+            _viewLength -= count;
+        }
+
+        /**
+         * @brief Drops characters from the back of the view.
+         *
+         * @param count The number of characters to drop; must not exceed length().
+         */
+        void remove_suffix(std::size_t count)
+        {
+            assert(count <= _viewLength);
+            _viewLength -= count;
+        }
+
+        /**
+         * @brief Compares the view to another one lexicographically, like std::string::compare().
+         *
+         * Characters are compared as unsigned char values, and a proper prefix orders
+         * before the longer view. The common prefix is scanned with the vectorized
+         * Simd::findMismatch, which stops at the first differing vector.
+         *
+         * @param compareView The characters to compare to.
+         * @return A negative value if the view orders first, 0 if the views are equal, a positive value otherwise.
+         */
+        int compare(StringView compareView) const
+        {
+            std::size_t common = _viewLength < compareView._viewLength ? _viewLength : compareView._viewLength;
+            std::size_t mismatch = Simd::findMismatch(_viewData, compareView._viewData, common);
+            if (mismatch != Simd::notFound)
+            {
+                return static_cast<unsigned char>(_viewData[mismatch]) < static_cast<unsigned char>(compareView._viewData[mismatch]) ? -1 : 1;
+            }
+            if (_viewLength == compareView._viewLength)
+            {
+                return 0;
+            }
+            return _viewLength < compareView._viewLength ? -1 : 1;
+        }
+
+        /**
+         * @brief Checks whether the view begins with the given characters.
+         *
+         * @param prefix The characters to look for.
+         * @return true if the view starts with the prefix, false otherwise.
+         */
+        bool starts_with(StringView prefix) const
+        {
+            return prefix._viewLength <= _viewLength && std::memcmp(_viewData, prefix._viewData, prefix._viewLength) == 0;
+        }
+
+        bool starts_with(char ch) const
+        {
+            return _viewLength > 0 && _viewData[0] == ch;
+        }
+
+        /**
+         * @brief Checks whether the view ends with the given characters.
+         *
+         * @param suffix The characters to look for.
+         * @return true if the view ends with the suffix, false otherwise.
+         */
+        bool ends_with(StringView suffix) const
+        {
+            return suffix._viewLength <= _viewLength
+                && std::memcmp(_viewData + _viewLength - suffix._viewLength, suffix._viewData, suffix._viewLength) == 0;
+        }
+
+        bool ends_with(char ch) const
+        {
+            return _viewLength > 0 && _viewData[_viewLength - 1] == ch;
+        }
+
+        /**
+         * @brief Finds the first occurrence of a character.
+         *
+         * Like all search functions, this runs a vectorized kernel (see Simd.hpp).
+         *
+         * @param ch The character to find.
+         * @param position The position to start searching at.
+         * @return The position of the character, or npos if it is not found.
+         */
+        std::size_t find(char ch, std::size_t position = 0) const
+        {
+            if (position >= _viewLength)
+            {
+                return npos;
+            }
+            return _offset(Simd::findChar(_viewData + position, _viewLength - position, ch), position);
+        }
+
+        /**
+         * @brief Finds the first occurrence of a substring.
+         *
+         * @param needle The substring to find.
+         * @param position The position to start searching at.
+         * @return The position of the substring, or npos if it is not found.
+         */
+        std::size_t find(StringView needle, std::size_t position = 0) const
+        {
+            if (position > _viewLength)
+            {
+                return npos;
+            }
+            return _offset(Simd::findSubstring(_viewData + position, _viewLength - position, needle._viewData, needle._viewLength), position);
+        }
+
+        /**
+         * @brief Finds the last occurrence of a character.
+         *
+         * @param ch The character to find.
+         * @param position The last position to consider (npos for the whole view).
+         * @return The position of the character, or npos if it is not found.
+         */
+        std::size_t rfind(char ch, std::size_t position = npos) const
+        {
+            if (_viewLength == 0)
+            {
+                return npos;
+            }
+            std::size_t searchLength = position < _viewLength ? position + 1 : _viewLength;
+            return Simd::findLastChar(_viewData, searchLength, ch);
+        }
+
+        /**
+         * @brief Finds the last occurrence of a substring.
+         *
+         * @param needle The substring to find.
+         * @param position The last starting position to consider (npos for the whole view).
+         * @return The position of the substring, or npos if it is not found.
+         */
+        std::size_t rfind(StringView needle, std::size_t position = npos) const
+        {
+            if (needle._viewLength > _viewLength)
+            {
+                return npos;
+            }
+            std::size_t lastStart = std::min(position, _viewLength - needle._viewLength);
+            return Simd::findLastSubstring(_viewData, lastStart + needle._viewLength, needle._viewData, needle._viewLength);
+        }
+
+        /**
+         * @brief Finds the first character that is one of the given characters.
+         *
+         * @param set The characters to look for.
+         * @param position The position to start searching at.
+         * @return The position of the first matching character, or npos if there is none.
+         */
+        std::size_t find_first_of(StringView set, std::size_t position = 0) const
+        {
+            if (position >= _viewLength)
+            {
+                return npos;
+            }
+            return _offset(Simd::findFirstOf(_viewData + position, _viewLength - position, set._viewData, set._viewLength), position);
+        }
+
+        /**
+         * @brief Counts the occurrences of a character.
+         *
+         * @param ch The character to count.
+         * @return The number of occurrences.
+         */
+        std::size_t count(char ch) const
+        {
+            return Simd::count(_viewData, _viewLength, ch);
+        }
+
+        /**
+         * @brief Counts the non-overlapping occurrences of a substring, left to right.
+         *
+         * @param needle The substring to count; an empty needle is never counted.
+         * @return The number of occurrences.
+         */
+        std::size_t count(StringView needle) const
+        {
+            std::size_t occurrences = 0;
+            if (needle.empty())
+            {
+                return occurrences;
+            }
+            for (std::size_t found = find(needle); found != npos; found = find(needle, found + needle._viewLength))
+            {
+                occurrences++;
+            }
+            return occurrences;
+        }
+
+        /**
+         * @brief Gets the hash of the characters; the same value as String::hash() for equal characters.
+         *
+         * @return The hash of the characters (never 0).
+         */
+        std::size_t hash() const
+        {
+            std::size_t viewHash = static_cast<std::size_t>(hashBytes(_viewData, _viewLength));
+            // 0 is reserved by String to mark a hash that is not computed yet.
+            return viewHash + (viewHash == 0);
+        }
+
+        /**
+         * @brief Checks whether the characters equal others, ignoring the case of ASCII letters.
+         *
+         * Bytes outside ASCII, such as UTF-8 sequences, must match exactly.
+         *
+         * @param other The characters to compare to.
+         * @return true if the characters differ only in the case of ASCII letters.
+         */
+        bool equalsIgnoreCase(StringView other) const
+        {
+            return _viewLength == other._viewLength && Simd::equalsIgnoreCase(_viewData, other._viewData, _viewLength);
+        }
+
+        /**
+         * @brief Gets a hash that ignores the case of ASCII letters, computed without a lowercased copy.
+         *
+         * @return The hash() of the characters with every ASCII letter lowercased (never 0).
+         */
+        std::size_t hashIgnoreCase() const
+        {
+            std::size_t viewHash = static_cast<std::size_t>(hashBytesIgnoreCase(_viewData, _viewLength));
+            return viewHash + (viewHash == 0);
+        }
+
+        /**
+         * @brief Copies the characters into a std::string.
+         *
+         * @return The new std::string.
+         */
+        std::string toStdString() const
+        {
+            return std::string(_viewData, _viewLength);
+        }
+
+        // #endregion
+
+        /**
+         * @brief Inserts the characters of the view into an output stream.
+         *
+         * The characters are written with a single write() of the known length, so null
+         * characters are written too. The field width and fill of the stream are honored,
+         * as for std::string.
+         *
+         * @param outputStream The output stream.
+         * @param outputView The view to insert.
+         *
+         * @return The output stream.
+         */
+        friend std::ostream& operator<<(std::ostream& outputStream, StringView outputView)
+        {
+            std::streamsize length = static_cast<std::streamsize>(outputView._viewLength);
+            std::streamsize padding = outputStream.width() > length ? outputStream.width() - length : 0;
+            bool padLeft = (outputStream.flags() & std::ios_base::adjustfield) != std::ios_base::left;
+
+            for (std::streamsize i = 0; padLeft && i < padding; ++i)
+            {
+                outputStream.put(outputStream.fill());
+            }
+            outputStream.write(outputView._viewData, length);
+            for (std::streamsize i = 0; !padLeft && i < padding; ++i)
+            {
+                outputStream.put(outputStream.fill());
+            }
+
+            outputStream.width(0);
+            return outputStream;
+        }
+
+    private:
+        /**
+         * @brief Converts a position relative to a search start back to a view position.
+         *
+         * @param found The result of a search kernel (Simd::notFound if nothing was found).
+         * @param start The position the search started at.
+         * @return The view position, or npos.
+         */
+        static std::size_t _offset(std::size_t found, std::size_t start)
+        {
+            return found == Simd::notFound ? npos : start + found;
+        }
+
+        const char* _viewData;      ///< The characters of the view (not owned).
+        std::size_t _viewLength;    ///< The number of characters in the view.
+    };
+
+    /**
+     * @struct CaseInsensitiveHash
+     * @brief Hashes keys ignoring the case of ASCII letters; use with CaseInsensitiveEqual.
+     *
+     * @code
+     * std::unordered_map<String, String, CaseInsensitiveHash, CaseInsensitiveEqual> headers;
+     * headers["Content-Type"] = "text/plain";
+     * headers.find("content-type");   // found
+     * @endcode
+     */
+    struct CaseInsensitiveHash
+    {
+        std::size_t operator()(StringView key) const noexcept
+        {
+            return key.hashIgnoreCase();
+        }
+    };
+
+    /**
+     * @struct CaseInsensitiveEqual
+     * @brief Compares keys ignoring the case of ASCII letters; use with CaseInsensitiveHash.
+     */
+    struct CaseInsensitiveEqual
+    {
+        bool operator()(StringView first, StringView second) const noexcept
+        {
+            return first.equalsIgnoreCase(second);
+        }
+    };
+
+    inline namespace Literals
+    {
+        /**
+         * @brief Makes a view of a string literal, e.g. `"GET"_sv`.
+         *
+         * The length comes from the compiler, so unlike the C-string constructor there is no
+         * strlen(), and the literal may contain null characters.
+         *
+         * @param literal The characters of the literal, in static storage.
+         * @param length The number of characters.
+         * @return A view of the literal.
+         */
+        constexpr StringView operator"" _sv(const char* literal, std::size_t length) noexcept
+        {
+            return StringView(literal, length);
+        }
+    }
+}
+
+namespace std
+{
+    /**
+     * @brief Hash specialization matching std::hash<UserDefined::String> for equal characters.
+     */
+    template <>
+    struct hash<UserDefined::StringView>
+    {
+        std::size_t operator()(UserDefined::StringView hashView) const noexcept
+        {
+            return hashView.hash();
+        }
+    };
+}
+
+#endif // STRING_VIEW_HPP
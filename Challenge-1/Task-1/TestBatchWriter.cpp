@@ -0,0 +1,91 @@
+/**************************************************************************************************
+ * @file TestBatchWriter.cpp
+ *
+ * @brief This file is used to test the UserDefined::BatchWriter class.
+ **************************************************************************************************/
+
+#include "BatchWriter.hpp"
+#include "String.hpp"
+#include <cassert>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Reads back everything written to a temporary file.
+     */
+    std::string readFile(std::FILE* file)
+    {
+        std::string contents;
+        char buffer[4096];
+        std::rewind(file);
+        for (std::size_t readCount; (readCount = std::fread(buffer, 1, sizeof(buffer), file)) > 0;)
+        {
+            contents.append(buffer, readCount);
+        }
+        return contents;
+    }
+}
+
+int main() {
+    // Build strings of many lengths, including long ones that are queued by reference
+    std::vector<UserDefined::String> lines;
+    std::string expected;
+    for (std::size_t i = 0; i < 5000; ++i)
+    {
+        std::string line(i * 37 % 700, static_cast<char>('a' + i % 26));
+        line += '\n';
+        lines.emplace_back(UserDefined::StringView(line));
+        expected += line;
+    }
+
+    // Test writing to an output stream
+    std::ostringstream output;
+    {
+        UserDefined::BatchWriter writer(output);
+        writer << "header\n";
+        for (const UserDefined::String& line : lines)
+        {
+            writer << line;
+        }
+        assert(writer.flush() && writer.pendingBytes() == 0);
+        writer << "footer";
+        assert(writer.pendingBytes() == 6);
+    }
+    std::cout << "Stream writer: " << output.str().size() << " bytes written" << std::endl;
+    assert(output.str() == "header\n" + expected + "footer");
+
+    // Test writing to a file descriptor with writev()
+    std::FILE* file = std::tmpfile();
+    assert(file);
+    {
+        UserDefined::BatchWriter writer(fileno(file));
+        for (const UserDefined::String& line : lines)
+        {
+            writer.add(line);
+        }
+        assert(writer.flush());
+    }
+    std::string fileContents = readFile(file);
+    std::cout << "Descriptor writer: " << fileContents.size() << " bytes written" << std::endl;
+    assert(fileContents == expected);
+    std::fclose(file);
+
+    // Test null characters are written
+    std::ostringstream binaryOutput;
+    {
+        UserDefined::BatchWriter writer(binaryOutput);
+        writer << UserDefined::String(std::vector<char>{ 'a', '\0', 'b' }) << UserDefined::StringView("\0c", 2);
+    }
+    assert(binaryOutput.str() == std::string("a\0b\0c", 5));
+
+    // Test a failing descriptor keeps the data queued
+    UserDefined::BatchWriter badWriter(-1);
+    badWriter << "lost";
+    assert(!badWriter.flush() && errno == EBADF && badWriter.pendingBytes() == 4);
+
+    return 0;
+}
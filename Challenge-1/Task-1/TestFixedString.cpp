@@ -0,0 +1,82 @@
+/**************************************************************************************************
+ * @file TestFixedString.cpp
+ *
+ * @brief This file is used to test the UserDefined::FixedString class and the _sv literal.
+ **************************************************************************************************/
+
+#include "String.hpp"
+#include "Split.hpp"
+#include <cassert>
+#include <sstream>
+
+namespace
+{
+    using namespace UserDefined::Literals;
+
+    /**
+     * @brief Builds a string at compile time.
+     */
+    constexpr UserDefined::FixedString<16> makeGreeting()
+    {
+        UserDefined::FixedString<16> greeting("Hello");
+        greeting += ", "_sv;
+        greeting.append("world"_sv);
+        greeting.push_back('!');
+        return greeting;
+    }
+
+    constexpr UserDefined::FixedString<16> greeting = makeGreeting();
+    constexpr auto method = UserDefined::makeFixedString("GET");
+    constexpr UserDefined::StringView separator = ": "_sv;
+
+    static_assert(greeting.length() == 13 && greeting[7] == 'w', "built at compile time");
+    static_assert(greeting == "Hello, world!"_sv, "compared at compile time");
+    static_assert(method.capacity() == 3 && method.length() == 3, "sized from the literal");
+    static_assert(separator.length() == 2 && separator[1] == ' ', "literal length known at compile time");
+    static_assert("a\0b"_sv.length() == 3, "literals may contain null characters");
+
+    void printTestOutput(const char* testName, UserDefined::StringView result)
+    {
+        std::cout << testName << ": " << result << std::endl;
+    }
+}
+
+int main() {
+    // Test fixed strings are usable as views
+    printTestOutput("Compile-time greeting", greeting);
+    assert(UserDefined::StringView(greeting).find("world") == 7);
+    assert(greeting.c_str()[greeting.length()] == '\0');
+    std::size_t tokenCount = 0;
+    for (UserDefined::StringView token : UserDefined::split(greeting, ' '))
+    {
+        tokenCount += !token.empty();
+    }
+    assert(tokenCount == 2);
+
+    // Test fixed strings and literals with String
+    UserDefined::String request(method);
+    request += " /index.html"_sv;
+    request.append(separator);
+    assert(request == UserDefined::String("GET /index.html: "));
+    UserDefined::String line = method + " " + greeting;
+    printTestOutput("Concatenation", line);
+    assert(line == UserDefined::String("GET Hello, world!"));
+    UserDefined::String fromLiteral("with\0null"_sv);
+    assert(fromLiteral.length() == 9 && fromLiteral.c_str()[4] == '\0');
+
+    // Test run-time use
+    UserDefined::FixedString<8> buffer;
+    assert(buffer.empty());
+    buffer += "abc";
+    buffer += 'd';
+    assert(buffer == "abcd"_sv && buffer != "abc"_sv);
+    buffer[0] = 'A';
+    buffer.clear();
+    assert(buffer.length() == 0 && buffer.c_str()[0] == '\0');
+    UserDefined::FixedString<4> copied(UserDefined::StringView("xyz"));
+    std::ostringstream output;
+    output << copied;
+    assert(output.str() == "xyz");
+
+    return 0;
+}
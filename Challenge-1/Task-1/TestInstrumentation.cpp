@@ -0,0 +1,146 @@
+/**************************************************************************************************
+ * @file TestInstrumentation.cpp
+ *
+ * @brief This file is used to test the allocation instrumentation of UserDefined::String.
+ **************************************************************************************************/
+
+#define USERDEFINED_STRING_INSTRUMENTATION
+
+#include "String.hpp"
+#include <cassert>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    using UserDefined::Instrumentation::Counters;
+    using UserDefined::Instrumentation::Snapshot;
+
+    void printTestOutput(const char* testName, const Counters& counters)
+    {
+        std::cout << testName << ": " << counters.allocations << " allocations, " << counters.allocatedBytes << " bytes, "
+                  << counters.copies << " copies, " << counters.moves << " moves, peak " << counters.peakLiveBytes << " live bytes" << std::endl;
+    }
+
+    const char* longText = "a string that is too long for the inline buffer";   // 47 characters
+}
+
+int main() {
+    static_assert(UserDefined::Instrumentation::enabled, "compiled with USERDEFINED_STRING_INSTRUMENTATION");
+
+    // Test short strings allocate nothing
+    {
+        Snapshot snapshot;
+        UserDefined::String shortString("short");
+        UserDefined::String copy(shortString);
+        UserDefined::String moved(std::move(copy));
+        Counters delta = snapshot.delta();
+        printTestOutput("Short strings", delta);
+        assert(delta.allocations == 0 && delta.allocatedBytes == 0);
+        assert(delta.copies == 1 && delta.moves == 1);
+    }
+
+    // Test a copy allocates and a move does not
+    {
+        UserDefined::String source(longText);
+        Snapshot snapshot;
+        UserDefined::String copy(source);
+        UserDefined::String moved(std::move(copy));
+        Counters delta = snapshot.delta();
+        printTestOutput("Copy and move", delta);
+        assert(delta.allocations == 1 && delta.allocatedBytes == 48);
+        assert(delta.copies == 1 && delta.moves == 1);
+        assert(delta.liveBytes == 48 && delta.peakLiveBytes == 48);
+    }
+
+    // Test assignments are counted and a reused buffer is not an allocation
+    {
+        UserDefined::String source(longText);
+        UserDefined::String target(longText);
+        Snapshot snapshot;
+        target = source;
+        target = std::move(source);
+        Counters delta = snapshot.delta();
+        assert(delta.copies == 1 && delta.moves == 1);
+        assert(delta.allocations == 0 && delta.deallocations == 1);
+    }
+
+    // Test the peak and the net change of a region
+    {
+        Snapshot snapshot;
+        {
+            UserDefined::String first(longText);
+            UserDefined::String second(longText);
+        }
+        UserDefined::String kept(longText);
+        Counters delta = snapshot.delta();
+        printTestOutput("Peak", delta);
+        assert(delta.allocations == 3 && delta.deallocations == 2);
+        assert(delta.peakLiveBytes == 96 && delta.liveBytes == 48);
+    }
+
+    // Test nested snapshots
+    {
+        Snapshot outer;
+        UserDefined::String first(longText);
+        UserDefined::String second(longText);
+        first = UserDefined::String();
+        second = UserDefined::String();
+        {
+            Snapshot inner;
+            UserDefined::String third(longText);
+            Counters innerDelta = inner.delta();
+            assert(innerDelta.allocations == 1 && innerDelta.peakLiveBytes == 48);
+        }
+        Counters outerDelta = outer.delta();
+        assert(outerDelta.allocations == 3 && outerDelta.moves == 2);
+        assert(outerDelta.peakLiveBytes == 96 && outerDelta.liveBytes == 0);
+    }
+
+    // Test counters are per thread
+    {
+        Snapshot snapshot;
+        std::size_t threadAllocations = 0;
+        std::thread worker([&threadAllocations]() {
+            Snapshot workerSnapshot;
+            UserDefined::String text(longText);
+            text += text;
+            threadAllocations = workerSnapshot.delta().allocations;
+        });
+        worker.join();
+        assert(threadAllocations == 2);
+        assert(snapshot.delta().allocations == 0);
+    }
+
+    // Test concatenation allocates once
+    {
+        UserDefined::String a(longText);
+        Snapshot snapshot;
+        UserDefined::String joined = a + " and " + a + " again";
+        Counters delta = snapshot.delta();
+        printTestOutput("Concatenation", delta);
+        assert(delta.allocations == 1 && delta.allocatedBytes == joined.length() + 1);
+    }
+
+    // Test adopted and released buffers keep the live bytes balanced
+    {
+        Snapshot snapshot;
+        UserDefined::String adopted(std::unique_ptr<char[]>(new char[64]), 0, 63);
+        UserDefined::String::OwnedBuffer released = adopted.release();
+        Counters delta = snapshot.delta();
+        assert(delta.allocatedBytes == 64 && delta.deallocatedBytes == 64 && delta.liveBytes == 0);
+    }
+
+    // Test releasing a short string counts the copy it makes
+    {
+        UserDefined::String shortString("short");
+        Snapshot snapshot;
+        UserDefined::String::OwnedBuffer released = shortString.release();
+        Counters delta = snapshot.delta();
+        assert(delta.allocations == 1 && delta.allocatedBytes == 6 && delta.deallocatedBytes == 6 && delta.liveBytes == 0);
+        UserDefined::String readopted(std::move(released));
+        assert(snapshot.delta().liveBytes == 6 && readopted == "short");
+    }
+
+    return 0;
+}
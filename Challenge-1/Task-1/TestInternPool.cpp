@@ -0,0 +1,96 @@
+/**************************************************************************************************
+ * @file TestInternPool.cpp
+ *
+ * @brief This file is used to test the UserDefined::InternPool class.
+ **************************************************************************************************/
+
+#include "InternPool.hpp"
+#include <cassert>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    void printTestOutput(const char* testName, const UserDefined::InternedString& str)
+    {
+        std::cout << testName << ": str = \"" << str << "\", length = " << str.length() << ", hash = " << str.hash() << std::endl;
+    }
+}
+
+int main() {
+    UserDefined::InternPool pool;
+
+    // Test default handle
+    UserDefined::InternedString i1;
+    printTestOutput("Default constructor", i1);
+    assert(i1.length() == 0 && std::strcmp(i1.c_str(), "") == 0);
+
+    // Test equal strings get the same handle, whatever they are interned from
+    UserDefined::String identifier("request_id");
+    UserDefined::InternedString i2 = pool.intern(identifier);
+    UserDefined::InternedString i3 = pool.intern("request_id");
+    UserDefined::InternedString i4 = pool.intern("request_id_suffix", 10);
+    printTestOutput("Intern String", i2);
+    UserDefined::InternedString i4View = pool.intern(UserDefined::StringView("GET request_id HTTP/1.1").substr(4, 10));
+    assert(i2 == i3 && i3 == i4 && i4 == i4View && i4View == pool.intern(std::string("request_id")));
+    assert(i2.c_str() == i3.c_str() && i2.hash() == i3.hash());
+    assert(pool.size() == 1);
+
+    // Test different strings get different handles
+    UserDefined::InternedString i5 = pool.intern("trace_id");
+    printTestOutput("Intern other string", i5);
+    assert(i5 != i2 && std::strcmp(i5.c_str(), "trace_id") == 0);
+
+    // Test embedded null characters and strings larger than an arena block
+    UserDefined::InternedString i6 = pool.intern("a\0b", 3);
+    assert(i6 != pool.intern("a\0c", 3) && i6 == pool.intern("a\0b", 3) && i6.length() == 3);
+    std::string large(100000, 'x');
+    UserDefined::InternedString i7 = pool.intern(large.c_str(), large.size());
+    assert(i7.length() == large.size() && i7 == pool.intern(large.c_str(), large.size()));
+
+    // Test handles stay valid while the tables grow
+    std::vector<UserDefined::InternedString> handles;
+    for (int i = 0; i < 10000; ++i)
+    {
+        handles.push_back(pool.intern(("identifier_" + std::to_string(i)).c_str()));
+    }
+    for (int i = 0; i < 10000; ++i)
+    {
+        assert(handles[i] == pool.intern(("identifier_" + std::to_string(i)).c_str()));
+        assert(("identifier_" + std::to_string(i)) == handles[i].c_str());
+    }
+    std::cout << "Grow: pool size = " << pool.size() << std::endl;
+    assert(pool.size() == 10005);
+
+    // Test handles as keys of an unordered container
+    std::unordered_set<UserDefined::InternedString> handleSet(handles.begin(), handles.end());
+    assert(handleSet.size() == 10000 && handleSet.count(pool.intern("identifier_42")) == 1);
+
+    // Test concurrent interning of overlapping strings yields one handle per string
+    UserDefined::InternPool concurrentPool;
+    std::vector<std::vector<UserDefined::InternedString>> results(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&concurrentPool, &results, t]() {
+            for (int i = 0; i < 5000; ++i)
+            {
+                results[t].push_back(concurrentPool.intern(("key_" + std::to_string(i)).c_str()));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (int t = 1; t < 4; ++t)
+    {
+        assert(results[t] == results[0]);
+    }
+    std::cout << "Concurrent interning: pool size = " << concurrentPool.size() << std::endl;
+    assert(concurrentPool.size() == 5000);
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**************************************************************************************************
+ * @file TestJoin.cpp
+ *
+ * @brief This file is used to test the UserDefined::join function.
+ **************************************************************************************************/
+
+#include "Join.hpp"
+#include "Split.hpp"
+#include <cassert>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void printTestOutput(const char* testName, const UserDefined::String& result)
+    {
+        std::cout << testName << ": " << result << std::endl;
+    }
+
+    /**
+     * @brief Joins with std::string, one piece at a time.
+     */
+    std::string expectedJoin(const std::vector<std::string>& pieces, const std::string& separator)
+    {
+        std::string joined;
+        for (std::size_t i = 0; i < pieces.size(); ++i)
+        {
+            if (i != 0)
+            {
+                joined += separator;
+            }
+            joined += pieces[i];
+        }
+        return joined;
+    }
+}
+
+int main() {
+    // Test joining Strings, std::strings and C-strings
+    std::vector<UserDefined::String> words = { "alpha", "beta", "a piece that is too long for the inline buffer" };
+    UserDefined::String joined = UserDefined::join(words, ", ");
+    printTestOutput("Join Strings", joined);
+    assert(joined == "alpha, beta, a piece that is too long for the inline buffer");
+    assert(joined.capacity() == joined.length());
+
+    std::vector<std::string> stdWords = { "x", "", "z" };
+    assert(UserDefined::join(stdWords, "--") == "x----z");
+    std::vector<const char*> cWords = { "usr", "local", "bin" };
+    assert(UserDefined::join(cWords, "/") == "usr/local/bin");
+    assert(UserDefined::join(cWords, "") == "usrlocalbin");
+
+    // Test empty ranges and a single piece
+    std::vector<UserDefined::String> none;
+    assert(UserDefined::join(none, ", ").length() == 0);
+    std::vector<UserDefined::String> single = { "only" };
+    assert(UserDefined::join(single, ", ") == "only");
+
+    // Test join reverses split
+    UserDefined::String csv("name,,age,city,");
+    std::vector<UserDefined::StringView> fields = UserDefined::split(csv, ',').toVector();
+    assert(UserDefined::join(fields, ",") == csv);
+    assert(UserDefined::join(UserDefined::split(csv, ','), " | ") == "name |  | age | city | ");
+
+    // Test the parallel copy agrees with the sequential one, with pieces cut across threads
+    std::mt19937 random(21);
+    for (int round = 0; round < 8; ++round)
+    {
+        std::vector<std::string> pieces;
+        std::size_t total = 0;
+        while (total < (std::size_t(5) << 20))
+        {
+            std::size_t length = random() % 4 == 0 ? 0 : random() % 3000;
+            if (random() % 500 == 0)
+            {
+                length = std::size_t(2) << 20;  // One piece larger than a thread's share.
+            }
+            pieces.emplace_back(length, static_cast<char>('a' + random() % 26));
+            total += length;
+        }
+        std::string separator(round % 3, ';');
+        std::string expected = expectedJoin(pieces, separator);
+
+        for (std::size_t threadCount : { 1, 2, 3, 4, 7 })
+        {
+            UserDefined::String parallel = UserDefined::join(pieces, separator, threadCount);
+            assert(parallel.length() == expected.size());
+            assert(std::memcmp(parallel.c_str(), expected.data(), expected.size()) == 0);
+        }
+    }
+    std::cout << "Parallel join: agrees with the sequential join" << std::endl;
+
+    return 0;
+}
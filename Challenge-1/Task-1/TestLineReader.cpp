@@ -0,0 +1,99 @@
+/**************************************************************************************************
+ * @file TestLineReader.cpp
+ *
+ * @brief This file is used to test the UserDefined::LineReader class.
+ **************************************************************************************************/
+
+#include "LineReader.hpp"
+#include <cassert>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Splits text into lines the simple way, as the reference for the reader.
+     */
+    std::vector<std::string> expectedLines(const std::string& text)
+    {
+        std::vector<std::string> lines;
+        std::istringstream input(text);
+        std::string line;
+        while (std::getline(input, line))
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    /**
+     * @brief Reads all lines of a text as views, with the given buffer size.
+     */
+    std::vector<std::string> readViews(const std::string& text, std::size_t bufferSize)
+    {
+        std::vector<std::string> lines;
+        std::istringstream input(text);
+        UserDefined::LineReader reader(input, bufferSize);
+        UserDefined::StringView line;
+        while (reader.readLine(line))
+        {
+            lines.push_back(line.toStdString());
+        }
+        return lines;
+    }
+}
+
+int main() {
+    // Test reading lines as views
+    std::istringstream input("first line\nsecond line\n\nlast line without newline");
+    UserDefined::LineReader reader(input);
+    UserDefined::StringView view;
+    assert(reader.readLine(view) && view == "first line");
+    std::cout << "View line: \"" << view << "\"" << std::endl;
+    assert(reader.readLine(view) && view == "second line");
+    assert(reader.readLine(view) && view.empty());
+    assert(reader.readLine(view) && view == "last line without newline");
+    assert(!reader.readLine(view) && !reader.readLine(view));
+
+    // Test empty input and a single newline
+    std::istringstream emptyInput("");
+    UserDefined::LineReader emptyReader(emptyInput);
+    assert(!emptyReader.readLine(view));
+    std::istringstream newlineInput("\n");
+    UserDefined::LineReader newlineReader(newlineInput);
+    assert(newlineReader.readLine(view) && view.empty() && !newlineReader.readLine(view));
+
+    // Test lines that cross buffer refills or are longer than the buffer
+    std::string text;
+    for (int i = 0; i < 200; ++i)
+    {
+        text += std::string(static_cast<std::size_t>(i * 7 % 53), static_cast<char>('a' + i % 26));
+        text += '\n';
+    }
+    text += std::string(1000, 'z');
+    for (std::size_t bufferSize : { 1, 7, 16, 64, 4096 })
+    {
+        assert(readViews(text, bufferSize) == expectedLines(text));
+    }
+    std::cout << "Buffer sizes: " << expectedLines(text).size() << " lines read correctly" << std::endl;
+
+    // Test reading into a String reuses its capacity
+    std::istringstream stringInput("a line that is longer than the inline buffer\nshort\nanother line, shorter than the first");
+    UserDefined::LineReader stringReader(stringInput, 16);
+    UserDefined::String line;
+    assert(stringReader.readLine(line) && line == UserDefined::String("a line that is longer than the inline buffer"));
+    const char* lineBuffer = line.c_str();
+    assert(stringReader.readLine(line) && line == UserDefined::String("short") && line.c_str() == lineBuffer);
+    assert(stringReader.readLine(line) && line.c_str() == lineBuffer);
+    std::cout << "String line: \"" << line << "\", capacity = " << line.capacity() << std::endl;
+    assert(!stringReader.readLine(line) && line == UserDefined::String("another line, shorter than the first"));
+
+    // Test lines with carriage returns and null characters are returned unchanged
+    std::istringstream binaryInput(std::string("a\r\nb\0c\n", 7));
+    UserDefined::LineReader binaryReader(binaryInput);
+    assert(binaryReader.readLine(view) && view == "a\r");
+    assert(binaryReader.readLine(view) && view == UserDefined::StringView("b\0c", 3));
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**************************************************************************************************
+ * @file TestMappedString.cpp
+ *
+ * @brief This file is used to test the UserDefined::MappedString class.
+ **************************************************************************************************/
+
+#include "MappedString.hpp"
+#include "Split.hpp"
+#include "String.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace
+{
+    /**
+     * @brief Writes a temporary file and returns its path.
+     */
+    std::string writeTemporaryFile(const std::string& contents)
+    {
+        char path[] = "/tmp/TestMappedStringXXXXXX";
+        int fileDescriptor = ::mkstemp(path);
+        assert(fileDescriptor >= 0);
+        assert(::write(fileDescriptor, contents.data(), contents.size()) == static_cast<ssize_t>(contents.size()));
+        ::close(fileDescriptor);
+        return path;
+    }
+}
+
+int main() {
+    std::string contents;
+    for (int i = 0; i < 100000; ++i)
+    {
+        contents += "record " + std::to_string(i) + ";value=" + std::to_string(i * 7) + "\n";
+    }
+    std::string path = writeTemporaryFile(contents);
+
+    // Test mapping a file and querying it like a view
+    UserDefined::MappedString mapped = UserDefined::MappedString::open(path.c_str());
+    assert(mapped.isOpen());
+    std::cout << "Mapped " << mapped.length() << " bytes" << std::endl;
+    assert(mapped.length() == contents.size());
+    assert(mapped.view() == UserDefined::StringView(contents));
+    assert(mapped[0] == 'r' && mapped.starts_with("record 0;") && mapped.ends_with("value=699993\n"));
+    assert(mapped.count('\n') == 100000);
+    assert(mapped.find("record 4242;") == contents.find("record 4242;"));
+    assert(mapped.rfind('r') == contents.rfind('r'));
+    assert(mapped.find_first_of("=;") == contents.find_first_of("=;"));
+    assert(mapped.substr(0, 8) == "record 0");
+    assert(mapped.hash() == UserDefined::String(mapped.view()).hash());
+
+    // Test splitting the mapping without copying it
+    std::size_t lineCount = 0;
+    for (UserDefined::StringView line : UserDefined::split(mapped, '\n'))
+    {
+        assert(line.empty() || (line.data() >= mapped.begin() && line.data() + line.length() <= mapped.end()));
+        lineCount++;
+    }
+    assert(lineCount == 100001);
+
+    // Test changing the access hint and moving the mapping
+    assert(mapped.advise(UserDefined::MappedString::Access::Random));
+    UserDefined::MappedString moved(std::move(mapped));
+    assert(!mapped.isOpen() && mapped.empty());
+    assert(moved.isOpen() && moved.length() == contents.size());
+    mapped = std::move(moved);
+    assert(mapped.find("record 99999;") != UserDefined::StringView::npos);
+
+    // Test an empty file and a missing file
+    std::string emptyPath = writeTemporaryFile("");
+    UserDefined::MappedString emptyMapping = UserDefined::MappedString::open(emptyPath.c_str(), UserDefined::MappedString::Access::WillNeed);
+    assert(emptyMapping.isOpen() && emptyMapping.empty() && emptyMapping.find('x') == UserDefined::StringView::npos);
+    UserDefined::MappedString missing = UserDefined::MappedString::open("/nonexistent/file");
+    assert(!missing.isOpen() && errno == ENOENT);
+    std::cout << "Missing file: " << std::strerror(errno) << std::endl;
+
+    std::remove(path.c_str());
+    std::remove(emptyPath.c_str());
+    return 0;
+}
@@ -0,0 +1,142 @@
+/**************************************************************************************************
+ * @file TestMultiMatcher.cpp
+ *
+ * @brief This file is used to test the UserDefined::MultiMatcher class.
+ **************************************************************************************************/
+
+#include "MultiMatcher.hpp"
+#include "String.hpp"
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Match = UserDefined::MultiMatcher::Match;
+
+    /**
+     * @brief Finds every occurrence of every pattern one pattern at a time, in the order MultiMatcher reports them.
+     */
+    std::vector<Match> findAllNaively(const std::vector<std::string>& patterns, const std::string& text)
+    {
+        std::vector<Match> matches;
+        for (std::size_t p = 0; p < patterns.size(); ++p)
+        {
+            for (std::size_t position = text.find(patterns[p]); position != std::string::npos; position = text.find(patterns[p], position + 1))
+            {
+                matches.push_back(Match{ p, position, patterns[p].size() });
+            }
+        }
+        std::stable_sort(matches.begin(), matches.end(), [](const Match& left, const Match& right) {
+            std::size_t leftEnd = left.position + left.length;
+            std::size_t rightEnd = right.position + right.length;
+            return leftEnd != rightEnd ? leftEnd < rightEnd : left.length > right.length;
+        });
+        return matches;
+    }
+
+    void printTestOutput(const char* testName, const std::vector<Match>& matches)
+    {
+        std::cout << testName << ":";
+        for (const Match& match : matches)
+        {
+            std::cout << " (" << match.pattern << " @" << match.position << ")";
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main() {
+    // Test the classic example, with overlapping matches
+    UserDefined::MultiMatcher matcher{ "he", "she", "his", "hers" };
+    assert(matcher.patternCount() == 4);
+    std::vector<Match> matches = matcher.findAll(UserDefined::String("ushers"));
+    printTestOutput("Find he/she/his/hers in \"ushers\"", matches);
+    assert((matches == std::vector<Match>{ { 1, 1, 3 }, { 0, 2, 2 }, { 3, 2, 4 } }));
+    assert(matcher.findAll("").empty());
+    assert(matcher.findAll("xyz").empty());
+
+    // Test patterns that are suffixes of one another, repeated patterns and single characters
+    UserDefined::MultiMatcher nested{ "a", "aa", "aaa", "aa" };
+    matches = nested.findAll("aaaa");
+    assert(matches.size() == 4 + 3 * 2 + 2);
+    assert((matches[0] == Match{ 0, 0, 1 }));
+    assert((matches[matches.size() - 1] == Match{ 0, 3, 1 }));
+
+    // Test containsAny
+    std::vector<UserDefined::StringView> keywords{ "error", "fatal", "panic" };
+    UserDefined::MultiMatcher alert(keywords);
+    assert(alert.containsAny("kernel: panic at 0x10"));
+    assert(!alert.containsAny("all systems nominal, no errr"));
+
+    // Test against a pattern-at-a-time search on random texts over a small alphabet
+    std::mt19937 random(20240611);
+    for (int round = 0; round < 200; ++round)
+    {
+        std::vector<std::string> patterns(1 + random() % 12);
+        for (std::string& pattern : patterns)
+        {
+            pattern.resize(1 + random() % 5);
+            for (char& ch : pattern)
+            {
+                ch = static_cast<char>('a' + random() % 3);
+            }
+        }
+        std::string text(random() % 300, ' ');
+        for (char& ch : text)
+        {
+            ch = static_cast<char>('a' + random() % 4);
+        }
+
+        UserDefined::MultiMatcher randomMatcher(std::vector<UserDefined::StringView>(patterns.begin(), patterns.end()));
+        assert(randomMatcher.findAll(text) == findAllNaively(patterns, text));
+        assert(randomMatcher.containsAny(text) == !findAllNaively(patterns, text).empty());
+    }
+    std::cout << "Random texts: 200 matchers agree with std::string::find" << std::endl;
+
+    // Test binary patterns and a set using every byte value
+    std::vector<std::string> bytePatterns;
+    for (int c = 0; c < 256; ++c)
+    {
+        bytePatterns.push_back(std::string(1, static_cast<char>(c)) + static_cast<char>(255 - c));
+    }
+    std::string binaryText;
+    for (int c = 0; c < 1024; ++c)
+    {
+        binaryText += static_cast<char>(c * 7);
+    }
+    binaryText += std::string("\0\xff", 2);
+    UserDefined::MultiMatcher byteMatcher(std::vector<UserDefined::StringView>(bytePatterns.begin(), bytePatterns.end()));
+    assert(byteMatcher.findAll(binaryText) == findAllNaively(bytePatterns, binaryText));
+    assert(byteMatcher.findAll(binaryText).back() == (Match{ 0, binaryText.size() - 2, 2 }));
+
+    // Test one matcher shared by several threads
+    std::string log;
+    for (int i = 0; i < 20000; ++i)
+    {
+        log += i % 97 == 0 ? "fatal: disk\n" : i % 13 == 0 ? "error: retry\n" : "info: ok\n";
+    }
+    std::size_t expectedCount = alert.findAll(log).size();
+    std::vector<std::size_t> counts(4, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < counts.size(); ++t)
+    {
+        threads.emplace_back([&alert, &log, &counts, t]() {
+            alert.scan(log, [&counts, t](const Match&) { counts[t]++; });
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    std::cout << "Concurrent scans: " << expectedCount << " matches each" << std::endl;
+    for (std::size_t count : counts)
+    {
+        assert(count == expectedCount);
+    }
+
+    return 0;
+}
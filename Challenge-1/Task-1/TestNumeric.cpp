@@ -0,0 +1,185 @@
+/**************************************************************************************************
+ * @file TestNumeric.cpp
+ *
+ * @brief This file is used to test the conversions between numbers and text in Numeric.hpp.
+ **************************************************************************************************/
+
+#include "String.hpp"
+#include <cassert>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace
+{
+    void printTestOutput(const char* testName, const UserDefined::String& result)
+    {
+        std::cout << testName << ": " << result << std::endl;
+    }
+
+    /**
+     * @brief Formats a double into a std::string.
+     */
+    std::string formatted(double value)
+    {
+        char buffer[UserDefined::maxDoubleLength];
+        return std::string(buffer, UserDefined::formatDouble(buffer, value));
+    }
+
+    /**
+     * @brief Counts the significant digits of text written by formatDouble().
+     */
+    std::size_t significantDigits(const std::string& text)
+    {
+        std::string digits;
+        for (char character : text.substr(0, text.find('e')))
+        {
+            if (character >= '0' && character <= '9')
+            {
+                digits += character;
+            }
+        }
+        std::size_t first = digits.find_first_not_of('0');
+        std::size_t last = digits.find_last_not_of('0');
+        return first == std::string::npos ? 0 : last - first + 1;
+    }
+}
+
+int main() {
+    // Test formatting integers
+    printTestOutput("fromInt", UserDefined::String::fromInt(-1234567));
+    assert(UserDefined::String::fromInt(0) == "0");
+    assert(UserDefined::String::fromInt(7) == "7");
+    assert(UserDefined::String::fromInt(-10) == "-10");
+    assert(UserDefined::String::fromInt(std::numeric_limits<long long>::min()) == "-9223372036854775808");
+    assert(UserDefined::String::fromInt(std::numeric_limits<unsigned long long>::max()) == "18446744073709551615");
+    assert(UserDefined::String::fromInt(static_cast<short>(-32768)) == "-32768");
+    assert(UserDefined::String::fromInt(static_cast<unsigned char>(255)) == "255");
+    std::mt19937_64 random(24);
+    for (int i = 0; i < 100000; ++i)
+    {
+        long long value = static_cast<long long>(random() >> (random() % 64)) * (i % 2 == 0 ? 1 : -1);
+        UserDefined::String text = UserDefined::String::fromInt(value);
+        assert(text == std::to_string(value).c_str());
+        long long parsed = 0;
+        assert(UserDefined::parseInt(text, parsed) && parsed == value);
+    }
+
+    // Test parsing integers
+    int parsedInt = 0;
+    assert(UserDefined::parseInt("-2147483648", parsedInt) && parsedInt == std::numeric_limits<int>::min());
+    assert(UserDefined::parseInt("0042", parsedInt) && parsedInt == 42);
+    assert(!UserDefined::parseInt("2147483648", parsedInt) && parsedInt == 42);
+    assert(!UserDefined::parseInt("", parsedInt) && !UserDefined::parseInt("-", parsedInt));
+    assert(!UserDefined::parseInt("+1", parsedInt) && !UserDefined::parseInt(" 1", parsedInt) && !UserDefined::parseInt("1x", parsedInt));
+    unsigned long long parsedUnsigned = 0;
+    assert(UserDefined::parseInt("18446744073709551615", parsedUnsigned) && parsedUnsigned == std::numeric_limits<unsigned long long>::max());
+    assert(!UserDefined::parseInt("18446744073709551616", parsedUnsigned) && !UserDefined::parseInt("-1", parsedUnsigned));
+    UserDefined::String fields("12,-7,300");
+    unsigned char parsedByte = 0;
+    assert(UserDefined::parseInt(UserDefined::StringView(fields).substr(3, 2), parsedInt) && parsedInt == -7);
+    assert(!UserDefined::parseInt(UserDefined::StringView(fields).substr(6), parsedByte));
+
+    // Test formatting doubles with the shortest round-trip digits
+    printTestOutput("fromDouble", UserDefined::String::fromDouble(0.1 + 0.2));
+    assert(UserDefined::String::fromDouble(0.1) == "0.1");
+    assert(UserDefined::String::fromDouble(0.30000000000000004) == "0.30000000000000004");
+    assert(UserDefined::String::fromDouble(1.5) == "1.5");
+    assert(UserDefined::String::fromDouble(-1250.0) == "-1250");
+    assert(UserDefined::String::fromDouble(100000.0) == "1e+05");
+    assert(UserDefined::String::fromDouble(123456.0) == "123456");
+    assert(UserDefined::String::fromDouble(0.001) == "0.001");
+    assert(UserDefined::String::fromDouble(1e-7) == "1e-07");
+    assert(UserDefined::String::fromDouble(1e100) == "1e+100");
+    assert(UserDefined::String::fromDouble(5e-324) == "5e-324");
+    assert(UserDefined::String::fromDouble(1.7976931348623157e308) == "1.7976931348623157e+308");
+    assert(UserDefined::String::fromDouble(9007199254740993.0) == "9007199254740992");
+    assert(UserDefined::String::fromDouble(0.0) == "0" && UserDefined::String::fromDouble(-0.0) == "-0");
+    assert(UserDefined::String::fromDouble(std::numeric_limits<double>::infinity()) == "inf");
+    assert(UserDefined::String::fromDouble(-std::numeric_limits<double>::infinity()) == "-inf");
+    assert(UserDefined::String::fromDouble(std::numeric_limits<double>::quiet_NaN()) == "nan");
+    assert(formatted(-2.2250738585072014e-308).size() == UserDefined::maxDoubleLength);
+
+    // Test random doubles round-trip and no shorter correctly rounded text reads back the same
+    for (int i = 0; i < 200000; ++i)
+    {
+        std::uint64_t bits = random();
+        if (i % 3 == 1)
+        {
+            bits &= 0x800FFFFFFFFFFFFFULL;  // Subnormal.
+        }
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value))
+        {
+            continue;
+        }
+        std::string text = formatted(value);
+        assert(std::strtod(text.c_str(), nullptr) == value);
+        std::size_t digits = significantDigits(text);
+        if (digits > 1)
+        {
+            char shorter[32];
+            std::snprintf(shorter, sizeof(shorter), "%.*e", static_cast<int>(digits) - 2, value);
+            assert(std::strtod(shorter, nullptr) != value);
+        }
+        double parsed = 0;
+        assert(UserDefined::parseDouble(text, parsed) && std::memcmp(&parsed, &value, sizeof(value)) == 0);
+    }
+
+    // Test parsing doubles agrees with strtod()
+    for (int i = 0; i < 200000; ++i)
+    {
+        std::string text = i % 2 == 0 ? "" : "-";
+        int digitCount = 1 + static_cast<int>(random() % 25);
+        int pointPosition = static_cast<int>(random() % (digitCount + 2)) - 1;
+        for (int d = 0; d < digitCount; ++d)
+        {
+            text += d == pointPosition ? "." : "";
+            text += static_cast<char>('0' + random() % 10);
+        }
+        if (random() % 2 == 0)
+        {
+            text += "e" + std::to_string(static_cast<int>(random() % 660) - 340);
+        }
+        double expected = std::strtod(text.c_str(), nullptr);
+        double parsed = 0;
+        bool parsedOk = UserDefined::parseDouble(text, parsed);
+        assert(parsedOk == !std::isinf(expected));
+        assert(!parsedOk || std::memcmp(&parsed, &expected, sizeof(parsed)) == 0);
+    }
+
+    // Test the grammar accepted by parseDouble
+    double parsedDouble = 0;
+    assert(UserDefined::parseDouble("19.99", parsedDouble) && parsedDouble == 19.99);
+    assert(UserDefined::parseDouble(".5", parsedDouble) && parsedDouble == 0.5);
+    assert(UserDefined::parseDouble("5.", parsedDouble) && parsedDouble == 5.0);
+    assert(UserDefined::parseDouble("-1E+3", parsedDouble) && parsedDouble == -1000.0);
+    assert(UserDefined::parseDouble("1e-400", parsedDouble) && parsedDouble == 0.0);
+    assert(UserDefined::parseDouble("-0", parsedDouble) && parsedDouble == 0.0 && std::signbit(parsedDouble));
+    assert(UserDefined::parseDouble("Infinity", parsedDouble) && parsedDouble == std::numeric_limits<double>::infinity());
+    assert(UserDefined::parseDouble("-inf", parsedDouble) && parsedDouble == -std::numeric_limits<double>::infinity());
+    assert(UserDefined::parseDouble("NaN", parsedDouble) && std::isnan(parsedDouble));
+    parsedDouble = 2.5;
+    assert(!UserDefined::parseDouble("", parsedDouble) && !UserDefined::parseDouble(".", parsedDouble));
+    assert(!UserDefined::parseDouble("1e", parsedDouble) && !UserDefined::parseDouble("1e+", parsedDouble));
+    assert(!UserDefined::parseDouble("1.2.3", parsedDouble) && !UserDefined::parseDouble(" 1", parsedDouble));
+    assert(!UserDefined::parseDouble("0x10", parsedDouble) && !UserDefined::parseDouble("infinit", parsedDouble));
+    assert(!UserDefined::parseDouble("1e309", parsedDouble) && parsedDouble == 2.5);
+
+    // Test the locale does not change the decimal point
+    if (std::setlocale(LC_ALL, "de_DE.UTF-8") != nullptr)
+    {
+        assert(UserDefined::String::fromDouble(2.5) == "2.5");
+        assert(UserDefined::parseDouble("2.5", parsedDouble) && parsedDouble == 2.5);
+        assert(UserDefined::parseDouble("2.50000000000000000000001", parsedDouble) && parsedDouble == 2.5);
+        std::setlocale(LC_ALL, "C");
+    }
+    std::cout << "Random round trips: agree with strtod()" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**************************************************************************************************
+ * @file TestRope.cpp
+ *
+ * @brief This file is used to test the UserDefined::Rope class.
+ **************************************************************************************************/
+
+#include "Rope.hpp"
+#include <cassert>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    void printTestOutput(const char* testName, const UserDefined::Rope& rope)
+    {
+        std::cout << testName << ": rope = \"" << rope << "\", length = " << rope.length() << std::endl;
+    }
+
+    bool equals(const UserDefined::Rope& rope, const std::string& expected)
+    {
+        UserDefined::String flat = rope.flatten();
+        return flat.length() == expected.size() && std::equal(expected.begin(), expected.end(), flat.c_str());
+    }
+}
+
+int main() {
+    // Test default constructor
+    UserDefined::Rope r1;
+    printTestOutput("Default constructor", r1);
+    assert(r1.length() == 0);
+    assert(r1.chunks().begin() == r1.chunks().end());
+
+    // Test construction from String and C-string
+    UserDefined::String hello("Hello");
+    UserDefined::Rope r2(hello);
+    UserDefined::Rope r3(", World");
+    printTestOutput("String constructor", r2);
+    assert(equals(r2, "Hello") && equals(r3, ", World"));
+
+    // Test concatenation shares the operands
+    UserDefined::Rope r4 = r2 + r3;
+    r4 += "!";
+    printTestOutput("Concatenation", r4);
+    assert(equals(r4, "Hello, World!"));
+    assert(equals(r2, "Hello"));
+    assert(r4.at(7) == 'W');
+
+    // Test substr, insert and erase
+    UserDefined::Rope r5 = r4.substr(7, 5);
+    printTestOutput("Substr", r5);
+    assert(equals(r5, "World"));
+    r5.insert(0, "Brave New ");
+    printTestOutput("Insert", r5);
+    assert(equals(r5, "Brave New World"));
+    r5.erase(5, 4);
+    printTestOutput("Erase", r5);
+    assert(equals(r5, "Brave World"));
+    assert(equals(r4.substr(7, 100), "World!"));
+
+    // Test zero-copy chunk iteration over large chunks
+    UserDefined::String big;
+    for (int i = 0; i < 1000; ++i)
+    {
+        big.append("0123456789");
+    }
+    UserDefined::Rope r6 = UserDefined::Rope(std::move(big)) + UserDefined::Rope("|") + r4.substr(0, 5);
+    std::size_t chunkCount = 0;
+    std::size_t chunkBytes = 0;
+    for (UserDefined::StringPiece chunk : r6.chunks())
+    {
+        chunkCount++;
+        chunkBytes += chunk.length();
+    }
+    std::cout << "Chunk iteration: " << chunkCount << " chunks, " << chunkBytes << " bytes" << std::endl;
+    assert(chunkBytes == 10006 && chunkCount == 3);
+
+    // Test stream output of a multi-chunk rope
+    std::ostringstream oss;
+    oss << r6.substr(9995, 11);
+    std::cout << "Operator<<: oss = \"" << oss.str() << "\"" << std::endl;
+    assert(oss.str() == "56789|Hello");
+
+    // Test random edits against std::string
+    std::mt19937 generator(42);
+    UserDefined::Rope r7;
+    std::string expected;
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::size_t position = generator() % (expected.size() + 1);
+        if (expected.size() < 1000 || generator() % 3)
+        {
+            std::string piece(1 + generator() % 40, static_cast<char>('a' + i % 26));
+            r7.insert(position, piece.c_str());
+            expected.insert(position, piece);
+        }
+        else
+        {
+            std::size_t count = generator() % 60;
+            r7.erase(position, count);
+            expected.erase(position, count);
+        }
+    }
+    std::cout << "Random edits: length = " << r7.length() << std::endl;
+    assert(equals(r7, expected));
+    for (std::size_t i = 0; i < expected.size(); i += 97)
+    {
+        assert(r7.at(i) == expected[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**************************************************************************************************
+ * @file TestSearcher.cpp
+ *
+ * @brief This file is used to test the UserDefined::Searcher class.
+ **************************************************************************************************/
+
+#include "Searcher.hpp"
+#include "String.hpp"
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <string>
+
+namespace
+{
+    using Strategy = UserDefined::Searcher::Strategy;
+
+    const char* strategyName(Strategy strategy)
+    {
+        switch (strategy)
+        {
+            case Strategy::Filter: return "Filter";
+            case Strategy::Horspool: return "Horspool";
+            default: return "TwoWay";
+        }
+    }
+
+    /**
+     * @brief Checks every strategy against std::string::find for all start positions.
+     */
+    void checkAllStrategies(const std::string& haystack, const std::string& needle)
+    {
+        for (Strategy strategy : { Strategy::Filter, Strategy::Horspool, Strategy::TwoWay })
+        {
+            UserDefined::Searcher searcher(needle, strategy);
+            for (std::size_t pos = 0; pos <= haystack.size() + 1; pos += 1 + pos / 8)
+            {
+                assert(searcher.find(haystack, pos) == haystack.find(needle, pos));
+            }
+        }
+    }
+}
+
+int main() {
+    // Test the automatic choice of strategy
+    std::string allBytes;
+    for (int i = 0; i < 1024; ++i)
+    {
+        allBytes += static_cast<char>(i * 37);
+    }
+    assert(UserDefined::Searcher("needle").strategy() == Strategy::Filter);
+    if (UserDefined::Simd::activeLevel() != UserDefined::Simd::Level::Scalar)
+    {
+        assert(UserDefined::Searcher(std::string(1024, 'n')).strategy() == Strategy::Filter);
+        assert(UserDefined::Searcher(allBytes).strategy() == Strategy::Horspool);
+    }
+    UserDefined::Simd::setLevel(UserDefined::Simd::Level::Scalar);
+    assert(UserDefined::Searcher("needle").strategy() == Strategy::Filter);
+    assert(UserDefined::Searcher("a longer needle").strategy() == Strategy::Horspool);
+    UserDefined::Simd::setLevel(UserDefined::Simd::supportedLevel());
+
+    // Test finding a needle in String haystacks
+    UserDefined::Searcher searcher("a fairly long needle that is searched for in many haystacks");
+    UserDefined::String haystack("hay hay a fairly long needle that is searched for in many haystacks, hay");
+    std::cout << "Searcher (" << strategyName(searcher.strategy()) << "): found at " << searcher.find(haystack) << std::endl;
+    assert(searcher.find(haystack) == 8);
+    assert(searcher.find(haystack, 9) == UserDefined::StringView::npos);
+    assert(searcher.find(UserDefined::String("too short")) == UserDefined::StringView::npos);
+    assert(searcher.needle() == UserDefined::StringView("a fairly long needle that is searched for in many haystacks"));
+
+    // Test empty and one-character needles and positions past the end
+    assert(UserDefined::Searcher("").find("abc") == 0);
+    assert(UserDefined::Searcher("").find("abc", 3) == 3);
+    assert(UserDefined::Searcher("").find("abc", 4) == UserDefined::StringView::npos);
+    assert(UserDefined::Searcher("c").find("abcabc", 3) == 5);
+
+    // Test every strategy on random periodic and aperiodic needles over small alphabets
+    std::mt19937 random(15);
+    for (int round = 0; round < 3000; ++round)
+    {
+        std::size_t alphabet = 1 + random() % 4;
+        std::string text(random() % 400, ' ');
+        for (char& ch : text)
+        {
+            ch = static_cast<char>('a' + random() % alphabet);
+        }
+
+        std::string needle;
+        std::size_t needleLength = 2 + random() % 70;
+        if (round % 3 == 0)
+        {
+            // A repeated short word: highly periodic.
+            std::string word(1 + random() % 4, ' ');
+            for (char& ch : word)
+            {
+                ch = static_cast<char>('a' + random() % alphabet);
+            }
+            while (needle.size() < needleLength)
+            {
+                needle += word;
+            }
+        }
+        else if (round % 3 == 1 && text.size() >= needleLength)
+        {
+            needle = text.substr(random() % (text.size() - needleLength + 1), needleLength);
+        }
+        else
+        {
+            needle.resize(needleLength);
+            for (char& ch : needle)
+            {
+                ch = static_cast<char>('a' + random() % (alphabet + 1));
+            }
+        }
+        checkAllStrategies(text, needle);
+    }
+    checkAllStrategies(std::string("\x80\xff\x80\x01\x80\xff\x80\xff\x80\xff\x01", 11), std::string("\x80\xff\x80\xff\x01", 5));
+    std::cout << "Random needles: all strategies agree with std::string::find" << std::endl;
+
+    // Test adversarial input stays linear (the fallback to Two-Way kicks in)
+    std::string adversarialText(std::size_t(8) << 20, 'a');
+    std::string adversarialNeedle = std::string(2047, 'a') + "b" + std::string(2048, 'a');
+    std::string adversarialMatch = adversarialText + adversarialNeedle;
+    for (Strategy strategy : { Strategy::Filter, Strategy::Horspool, Strategy::TwoWay })
+    {
+        UserDefined::Searcher adversarial(adversarialNeedle, strategy);
+        auto start = std::chrono::steady_clock::now();
+        assert(adversarial.find(adversarialText) == UserDefined::StringView::npos);
+        assert(adversarial.find(adversarialMatch, 1) == adversarialText.size());
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Adversarial inputs (8 MB, 4 KB needle) [" << strategyName(strategy) << "]: " << elapsed << " ms" << std::endl;
+        assert(elapsed < 2000);
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**************************************************************************************************
+ * @file TestSharedString.cpp
+ *
+ * @brief This file is used to test the UserDefined::SharedString class.
+ **************************************************************************************************/
+
+#include "SharedString.hpp"
+#include <cassert>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    void printTestOutput(const char* testName, const UserDefined::SharedString& str)
+    {
+        std::cout << testName << ": str = \"" << str << "\", length = " << str.length() << ", useCount = " << str.useCount() << std::endl;
+    }
+}
+
+int main() {
+    // Test default constructor
+    UserDefined::SharedString s1;
+    printTestOutput("Default constructor", s1);
+    assert(s1.length() == 0 && s1.useCount() == 0 && std::strcmp(s1.c_str(), "") == 0);
+
+    // Test construction from a String rvalue does not copy the heap buffer
+    UserDefined::String payload("A payload that is long enough to live on the heap");
+    const char* payloadData = payload.c_str();
+    UserDefined::SharedString s2(std::move(payload));
+    printTestOutput("String rvalue constructor", s2);
+    assert(s2.c_str() == payloadData);
+
+    // Test copies share the same characters
+    UserDefined::SharedString s3(s2);
+    UserDefined::SharedString s4;
+    s4 = s3;
+    printTestOutput("Copy constructor", s3);
+    assert(s2.useCount() == 3 && s3.c_str() == payloadData && s4.c_str() == payloadData);
+    assert(s2 == s4);
+
+    // Test move leaves the source empty without changing the count
+    UserDefined::SharedString s5(std::move(s4));
+    printTestOutput("Move constructor", s5);
+    assert(s4.useCount() == 0 && s5.useCount() == 3);
+
+    // Test toString() copies while the string is shared
+    UserDefined::String copied = UserDefined::SharedString(s5).toString();
+    assert(copied.c_str() != payloadData && copied == s5.str());
+
+    // Test toString() moves the buffer out once the reference is unique
+    s3 = UserDefined::SharedString();
+    s5 = UserDefined::SharedString();
+    assert(s2.unique());
+    UserDefined::String released = std::move(s2).toString();
+    std::cout << "Unique toString: str = \"" << released << "\"" << std::endl;
+    assert(released.c_str() == payloadData && s2.useCount() == 0);
+
+    // Test concurrent copies from several threads
+    UserDefined::SharedString shared("shared between threads");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&shared]() {
+            for (int i = 0; i < 100000; ++i)
+            {
+                UserDefined::SharedString local(shared);
+                assert(local.length() == 22);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    printTestOutput("Concurrent copies", shared);
+    assert(shared.unique());
+
+    return 0;
+}
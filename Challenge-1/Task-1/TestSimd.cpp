@@ -0,0 +1,135 @@
+/**************************************************************************************************
+ * @file TestSimd.cpp
+ *
+ * @brief This file is used to test the kernels of Simd.hpp at every supported level.
+ **************************************************************************************************/
+
+#include "Simd.hpp"
+#include <cassert>
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace
+{
+    const char* levelName(UserDefined::Simd::Level level)
+    {
+        switch (level)
+        {
+            case UserDefined::Simd::Level::AVX2: return "AVX2";
+            case UserDefined::Simd::Level::SSE2: return "SSE2";
+            default: return "Scalar";
+        }
+    }
+
+    char asciiLower(char ch)
+    {
+        return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch + 32) : ch;
+    }
+
+    std::size_t expected(std::size_t position)
+    {
+        return position == std::string::npos ? UserDefined::Simd::notFound : position;
+    }
+}
+
+int main() {
+    std::mt19937 generator(7);
+
+    for (auto level : { UserDefined::Simd::Level::Scalar, UserDefined::Simd::Level::SSE2, UserDefined::Simd::Level::AVX2 })
+    {
+        if (UserDefined::Simd::setLevel(level) != level)
+        {
+            std::cout << "Level " << levelName(level) << ": not supported, skipped" << std::endl;
+            continue;
+        }
+
+        std::size_t checks = 0;
+        for (int round = 0; round < 3000; ++round)
+        {
+            // Small alphabets make matches (and near matches) frequent; include bytes above 127.
+            std::size_t length = generator() % 300;
+            int alphabet = 2 + generator() % 6;
+            std::string haystack;
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                haystack.push_back(static_cast<char>((round % 2 ? 'a' : 0xF0) + generator() % alphabet));
+            }
+
+            char ch = static_cast<char>((round % 2 ? 'a' : 0xF0) + generator() % (alphabet + 1));
+            std::string needle = haystack.substr(length ? generator() % length : 0, generator() % 6);
+            if (generator() % 4 == 0 && !needle.empty())
+            {
+                needle.back() = ch;
+            }
+            std::string set;
+            for (std::size_t i = 0, setLength = generator() % 20; i < setLength; ++i)
+            {
+                set.push_back(static_cast<char>(generator() % 256));
+            }
+            if (generator() % 2)
+            {
+                set.push_back(ch);
+            }
+
+            const char* data = haystack.data();
+            assert(UserDefined::Simd::findChar(data, length, ch) == expected(haystack.find(ch)));
+            assert(UserDefined::Simd::findLastChar(data, length, ch) == expected(haystack.rfind(ch)));
+            assert(UserDefined::Simd::findSubstring(data, length, needle.data(), needle.size()) == expected(haystack.find(needle)));
+            assert(UserDefined::Simd::findLastSubstring(data, length, needle.data(), needle.size()) == expected(haystack.rfind(needle)));
+            assert(UserDefined::Simd::findFirstOf(data, length, set.data(), set.size()) == expected(haystack.find_first_of(set)));
+            assert(UserDefined::Simd::count(data, length, ch) == static_cast<std::size_t>(std::count(haystack.begin(), haystack.end(), ch)));
+
+            // A copy with one character changed, or none.
+            std::string other = haystack;
+            if (length && generator() % 4 != 0)
+            {
+                other[generator() % length] ^= static_cast<char>(1 + generator() % 255);
+            }
+            std::size_t mismatch = static_cast<std::size_t>(std::mismatch(haystack.begin(), haystack.end(), other.begin()).first - haystack.begin());
+            assert(UserDefined::Simd::findMismatch(data, other.data(), length) == (mismatch == length ? UserDefined::Simd::notFound : mismatch));
+
+            // Case conversion of mixed-case letters, punctuation and bytes above 127, copied and in place.
+            std::string mixed;
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                mixed.push_back(static_cast<char>(round % 2 ? '@' + generator() % 60 : generator() % 256));
+            }
+            std::string lower = mixed;
+            std::string upper = mixed;
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                lower[i] = asciiLower(mixed[i]);
+                upper[i] = mixed[i] >= 'a' && mixed[i] <= 'z' ? static_cast<char>(mixed[i] - 32) : mixed[i];
+            }
+            std::string converted(length, '\0');
+            UserDefined::Simd::toLower(mixed.data(), &converted[0], length);
+            assert(converted == lower);
+            converted = mixed;
+            UserDefined::Simd::toUpper(converted.data(), &converted[0], length);
+            assert(converted == upper);
+
+            std::string otherCase = upper;
+            if (length && generator() % 3 == 0)
+            {
+                otherCase[generator() % length] ^= static_cast<char>(1 << generator() % 8);
+            }
+            bool equalIgnoringCase = true;
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                equalIgnoringCase &= asciiLower(mixed[i]) == asciiLower(otherCase[i]);
+            }
+            assert(UserDefined::Simd::equalsIgnoreCase(mixed.data(), otherCase.data(), length) == equalIgnoringCase);
+            checks += 10;
+        }
+
+        // Counting must not overflow the per-byte accumulators on long inputs.
+        std::string ones(100000, '1');
+        assert(UserDefined::Simd::count(ones.data(), ones.size(), '1') == ones.size());
+
+        std::cout << "Level " << levelName(level) << ": " << checks << " checks passed" << std::endl;
+    }
+
+    return 0;
+}
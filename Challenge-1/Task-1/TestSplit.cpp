@@ -0,0 +1,98 @@
+/**************************************************************************************************
+ * @file TestSplit.cpp
+ *
+ * @brief This file is used to test the UserDefined::split() and splitAny() ranges.
+ **************************************************************************************************/
+
+#include "Split.hpp"
+#include "String.hpp"
+#include <cassert>
+#include <string>
+#include <vector>
+
+namespace
+{
+    template <typename Range>
+    std::vector<std::string> tokensOf(const Range& range)
+    {
+        std::vector<std::string> tokens;
+        for (UserDefined::StringView token : range)
+        {
+            tokens.push_back(token.toStdString());
+        }
+        return tokens;
+    }
+
+    void printTestOutput(const char* testName, const std::vector<std::string>& tokens)
+    {
+        std::cout << testName << ":";
+        for (const std::string& token : tokens)
+        {
+            std::cout << " [" << token << "]";
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main() {
+    using Tokens = std::vector<std::string>;
+
+    // Test splitting at a character, keeping empty tokens
+    UserDefined::String csv("id,name,,email,");
+    Tokens tokens = tokensOf(UserDefined::split(csv, ','));
+    printTestOutput("Split at ','", tokens);
+    assert((tokens == Tokens{ "id", "name", "", "email", "" }));
+    assert((tokensOf(UserDefined::split("", ',')) == Tokens{ "" }));
+    assert((tokensOf(UserDefined::split("no delimiter", ',')) == Tokens{ "no delimiter" }));
+    assert((tokensOf(UserDefined::split(",", ',')) == Tokens{ "", "" }));
+
+    // Test tokens are views into the split string
+    auto range = UserDefined::split(csv, ',');
+    auto it = range.begin();
+    ++it;
+    assert(it->data() == csv.c_str() + 3 && it->length() == 4);
+    assert(std::distance(range.begin(), range.end()) == 5);
+
+    // Test splitting at a multi-character delimiter
+    tokens = tokensOf(UserDefined::split("key: value:: other::::x", "::"));
+    printTestOutput("Split at \"::\"", tokens);
+    assert((tokens == Tokens{ "key: value", " other", "", "x" }));
+    assert((tokensOf(UserDefined::split("aaaa", "aa")) == Tokens{ "", "", "" }));
+
+    // Test splitting at any character of a set
+    tokens = tokensOf(UserDefined::splitAny("a b\tc\n\nd", " \t\n"));
+    printTestOutput("Split at any of \" \\t\\n\"", tokens);
+    assert((tokens == Tokens{ "a", "b", "c", "", "d" }));
+    std::string longLine;
+    for (int i = 0; i < 100; ++i)
+    {
+        longLine += "field" + std::to_string(i) + (i % 3 == 0 ? ";" : i % 3 == 1 ? "|" : "\x80");
+    }
+    tokens = tokensOf(UserDefined::splitAny(longLine, ";|\x80"));
+    assert(tokens.size() == 101 && tokens[42] == "field42" && tokens[100].empty());
+
+    // Test collecting tokens, sequentially and on several threads
+    std::string large;
+    std::vector<std::string> expected;
+    for (std::size_t i = 0; large.size() < (std::size_t(3) << 20); ++i)
+    {
+        expected.push_back(std::string(i % 17, static_cast<char>('a' + i % 26)));
+        large += expected.back();
+        large += i % 2 ? ',' : ';';
+    }
+    expected.push_back("");
+    for (std::size_t threadCount : { 1, 2, 3, 4, 8 })
+    {
+        std::vector<UserDefined::StringView> collected = UserDefined::splitAny(large, ",;").toVector(threadCount);
+        assert(collected.size() == expected.size());
+        for (std::size_t i = 0; i < collected.size(); ++i)
+        {
+            assert(collected[i] == expected[i]);
+        }
+    }
+    std::cout << "Parallel split: " << expected.size() << " tokens" << std::endl;
+    assert(UserDefined::split(large, ';').toVector(4).size() == UserDefined::split(large, ';').toVector().size());
+    assert(UserDefined::split(large, ",").toVector(4).size() == UserDefined::split(large, ',').toVector(4).size());
+
+    return 0;
+}
@@ -8,14 +8,61 @@
 
 #include "String.hpp"
 #include <cassert>
+#include <iomanip>
+#include <map>
+#include <random>
 #include <sstream>
+#include <unordered_map>
 
 namespace
 {
+    /**
+     * @class CountingResource
+     * @brief A memory resource that checks every deallocation matches an allocation.
+     */
+    class CountingResource : public UserDefined::MemoryResource
+    {
+    public:
+        std::size_t allocations = 0;
+        std::size_t liveBytes = 0;
+
+    protected:
+        void* doAllocate(std::size_t bytes, std::size_t alignment) override
+        {
+            allocations++;
+            liveBytes += bytes;
+            return UserDefined::newDeleteResource()->allocate(bytes, alignment);
+        }
+
+        void doDeallocate(void* memory, std::size_t bytes, std::size_t alignment) override
+        {
+            assert(liveBytes >= bytes);
+            liveBytes -= bytes;
+            UserDefined::newDeleteResource()->deallocate(memory, bytes, alignment);
+        }
+
+        bool doIsEqual(const UserDefined::MemoryResource&) const noexcept override
+        {
+            return false;
+        }
+    };
+
     void printTestOutput(const char* testName, const UserDefined::String& str)
     {
         std::cout << testName << ": str = \"" << str << "\", length = " << str.length() << std::endl;
     }
+
+    /**
+     * @brief Replaces every non-overlapping occurrence with std::string, for comparison.
+     */
+    std::string expectedReplaceAll(std::string text, const std::string& needle, const std::string& replacement)
+    {
+        for (std::size_t found = text.find(needle); found != std::string::npos; found = text.find(needle, found + replacement.size()))
+        {
+            text.replace(found, needle.size(), replacement);
+        }
+        return text;
+    }
 }
 
 int main() {
@@ -78,6 +125,15 @@ int main() {
     std::cout << "Operator<<: oss = \"" << oss.str() << "\"" << std::endl;
     assert(oss.str() == "Hello");
 
+    // Test operator<< writes embedded null characters and honors the field width
+    std::ostringstream binaryOss;
+    binaryOss << UserDefined::String(std::vector<char>{ 'a', '\0', 'b' });
+    assert(binaryOss.str() == std::string("a\0b", 3));
+    std::ostringstream paddedOss;
+    paddedOss << std::setw(8) << s2 << '|' << std::left << std::setfill('.') << std::setw(7) << s2 << '|' << s2;
+    std::cout << "Operator<< with width: \"" << paddedOss.str() << "\"" << std::endl;
+    assert(paddedOss.str() == "   Hello|Hello..|Hello");
+
     // Test operator>>
     std::istringstream iss("Hello");
     UserDefined::String s8;
@@ -86,5 +142,392 @@ int main() {
     assert(s8.length() == 5);
     assert(std::strcmp(s8.c_str(), "Hello") == 0);
 
+    // Test small-string boundary (23 characters fit inline, 24 go to the heap)
+    UserDefined::String s9("abcdefghijklmnopqrstuvw");
+    UserDefined::String s10("abcdefghijklmnopqrstuvwx");
+    printTestOutput("Inline boundary", s9);
+    printTestOutput("Heap boundary", s10);
+    assert(s9.length() == 23 && s10.length() == 24);
+    assert(std::strcmp(UserDefined::String(s9 + s10).c_str(), "abcdefghijklmnopqrstuvwabcdefghijklmnopqrstuvwx") == 0);
+
+    // Test moving inline and heap strings leaves the source empty
+    UserDefined::String s11(std::move(s9));
+    UserDefined::String s12;
+    s12 = std::move(s10);
+    printTestOutput("Move inline string", s11);
+    printTestOutput("Move heap string", s12);
+    assert(s9.length() == 0 && std::strcmp(s9.c_str(), "") == 0);
+    assert(s10.length() == 0 && std::strcmp(s10.c_str(), "") == 0);
+    assert(std::strcmp(s11.c_str(), "abcdefghijklmnopqrstuvw") == 0);
+    assert(std::strcmp(s12.c_str(), "abcdefghijklmnopqrstuvwx") == 0);
+
+    // Test copy assignment switching between heap and inline storage
+    s12 = s2;
+    s11 = s7 + s7 + s7;
+    printTestOutput("Copy assignment heap to inline", s12);
+    printTestOutput("Copy assignment inline to heap", s11);
+    assert(std::strcmp(s12.c_str(), "Hello") == 0);
+    assert(s11.length() == 30);
+
+    // Test operator>> growing past the inline buffer
+    std::istringstream longIss("The quick brown fox jumps over the lazy dog\nsecond line");
+    UserDefined::String s13;
+    longIss >> s13;
+    printTestOutput("Operator>> long line", s13);
+    assert(std::strcmp(s13.c_str(), "The quick brown fox jumps over the lazy dog") == 0);
+    longIss >> s13;
+    assert(std::strcmp(s13.c_str(), "second line") == 0);
+    assert(!longIss.fail() && longIss.eof());
+
+    // Test operator>> reuses the capacity of the string and reads lines of any length
+    const char* s13Buffer = s13.c_str();
+    std::istringstream reuseIss("short\n" + std::string(1000, 'x') + "\n\nlast");
+    reuseIss >> s13;
+    assert(std::strcmp(s13.c_str(), "short") == 0 && s13.c_str() == s13Buffer);
+    reuseIss >> s13;
+    assert(s13.length() == 1000 && s13.count('x') == 1000 && s13.capacity() >= 1000);
+    const char* s13LongBuffer = s13.c_str();
+    reuseIss >> s13;
+    assert(s13.length() == 0 && s13.c_str() == s13LongBuffer && !reuseIss.fail());
+    reuseIss >> s13;
+    assert(std::strcmp(s13.c_str(), "last") == 0 && !reuseIss.fail());
+    reuseIss >> s13;
+    assert(s13.length() == 0 && reuseIss.fail());
+
+    // Test append, operator+= and push_back
+    UserDefined::String s14;
+    s14.append("Hello").append(", ", 2);
+    s14 += s22;
+    s14 += '!';
+    s14.push_back('?');
+    printTestOutput("Append", s14);
+    assert(std::strcmp(s14.c_str(), "Hello, World!?") == 0);
+
+    // Test appending a string to itself across a reallocation
+    s14 += s14;
+    printTestOutput("Self append", s14);
+    assert(std::strcmp(s14.c_str(), "Hello, World!?Hello, World!?") == 0);
+
+    // Test geometric growth keeps appends amortized
+    UserDefined::String s15;
+    std::size_t reallocations = 0;
+    for (std::size_t i = 0; i < 100000; ++i)
+    {
+        std::size_t oldCapacity = s15.capacity();
+        s15.push_back(static_cast<char>('a' + i % 26));
+        reallocations += s15.capacity() != oldCapacity;
+    }
+    std::cout << "Push back 100000 characters: " << reallocations << " reallocations, capacity = " << s15.capacity() << std::endl;
+    assert(s15.length() == 100000 && s15.c_str()[99999] == 'a' + 99999 % 26);
+    assert(reallocations < 20);
+
+    // Test reserve, clear and shrink_to_fit
+    UserDefined::String s16("Hi");
+    s16.reserve(1000);
+    printTestOutput("Reserve", s16);
+    assert(s16.capacity() >= 1000 && std::strcmp(s16.c_str(), "Hi") == 0);
+    s16.clear();
+    assert(s16.length() == 0 && s16.capacity() >= 1000 && std::strcmp(s16.c_str(), "") == 0);
+    s16 += "short again";
+    s16.shrink_to_fit();
+    printTestOutput("Shrink to fit", s16);
+    assert(s16.capacity() < 1000 && std::strcmp(s16.c_str(), "short again") == 0);
+    s15.shrink_to_fit();
+    assert(s15.capacity() == s15.length());
+
+    // Test chained operator+ with mixed operands
+    std::string stdWorld("World");
+    UserDefined::String s17 = s2 + ", " + stdWorld + "!" + s2 + s22;
+    printTestOutput("Operator+ chain", s17);
+    assert(std::strcmp(s17.c_str(), "Hello, World!HelloWorld") == 0);
+    UserDefined::String s18 = "<" + s2 + ">";
+    printTestOutput("Operator+ C-string left operand", s18);
+    assert(std::strcmp(s18.c_str(), "<Hello>") == 0);
+
+    // Test assigning a concatenation that refers to the target itself
+    s18 = s18 + s18 + s2;
+    printTestOutput("Operator+ self assignment", s18);
+    assert(std::strcmp(s18.c_str(), "<Hello><Hello>Hello") == 0);
+
+    // Test comparing a concatenation without materializing it
+    assert((s2 + s22) == UserDefined::String("HelloWorld") && UserDefined::String("HelloWorld") == s2 + s22);
+    assert((s2 + ", " + stdWorld) == "Hello, World" && "Hello, World" == s2 + ", " + stdWorld);
+    assert((s2 + s22) != "HelloWorlds" && (s2 + s22) != "HelloWorle" && s2 != s2 + s22);
+    assert((s2 + s22) == ("Hell" + UserDefined::StringView("oWorld")) && (s2 + s2) != (s2 + s22));
+
+    // Test a concatenation with a temporary String operand is materialized before the temporary dies
+    auto withTemporary = s2 + UserDefined::String(", a temporary that is long enough for the heap");
+    UserDefined::String copiedTemporary = withTemporary;
+    assert(copiedTemporary == "Hello, a temporary that is long enough for the heap");
+    static_assert(std::is_same<decltype(withTemporary), UserDefined::String>::value, "temporaries must not be borrowed");
+    static_assert(!std::is_same<decltype(s2 + s22), UserDefined::String>::value, "named operands stay lazy");
+
+    // Test strings allocate from the resource they are given, with matching deallocation sizes
+    CountingResource counting;
+    {
+        UserDefined::String r1("A string that is long enough for the heap", &counting);
+        UserDefined::String r2(&counting);
+        for (int i = 0; i < 1000; ++i)
+        {
+            r2.push_back('x');
+        }
+        r2.shrink_to_fit();
+        r2 = r1;
+        std::istringstream resourceIss("Another line that does not fit in the inline buffer, read char by char");
+        resourceIss >> r2;
+        r2 = r1 + r1;
+        printTestOutput("Counting resource", r2);
+        assert(r1.memoryResource() == &counting && r2.memoryResource() == &counting);
+        assert(counting.allocations > 0 && counting.liveBytes > 0);
+
+        // Copies use the default resource; moves keep the resource of the source
+        UserDefined::String r3(r1);
+        UserDefined::String r4(std::move(r1));
+        assert(r3.memoryResource() == UserDefined::defaultResource() && r4.memoryResource() == &counting);
+
+        // Move assignment between different resources copies the characters
+        r3 = std::move(r4);
+        assert(r3.memoryResource() == UserDefined::defaultResource());
+        assert(std::strcmp(r3.c_str(), "A string that is long enough for the heap") == 0);
+    }
+    std::cout << "Counting resource: " << counting.allocations << " allocations, " << counting.liveBytes << " bytes live" << std::endl;
+    assert(counting.liveBytes == 0);
+
+    // Test per-request strings in a monotonic arena backed by a stack buffer
+    char stackBuffer[256];
+    UserDefined::MonotonicArena arena(stackBuffer, sizeof(stackBuffer), &counting);
+    {
+        UserDefined::String a1("Request scoped string number one", &arena);
+        UserDefined::String a2("Request scoped string number two", &arena);
+        a1 += a2;
+        printTestOutput("Monotonic arena", a1);
+        assert(a1.c_str() >= stackBuffer && a1.c_str() < stackBuffer + sizeof(stackBuffer));
+        UserDefined::String a3(std::string(1000, 'z').c_str(), &arena);
+        assert(a3.length() == 1000 && counting.liveBytes > 0);
+    }
+    arena.release();
+    assert(counting.liveBytes == 0);
+
+    // Test assign reuses the buffer and accepts part of the string itself
+    UserDefined::String assigned("A string that is long enough for the heap");
+    const char* assignedBuffer = assigned.c_str();
+    assigned.assign("short");
+    assert(assigned == UserDefined::String("short") && assigned.c_str() == assignedBuffer);
+    assigned.assign("a longer string that lives on the heap as well");
+    assigned.assign(UserDefined::StringView(assigned).substr(2, 6));
+    printTestOutput("Assign", assigned);
+    assert(assigned == UserDefined::String("longer"));
+
+    // Test find, rfind, find_first_of and count
+    UserDefined::String haystack("key=value; other=thing; key=again");
+    printTestOutput("Search haystack", haystack);
+    assert(haystack.find('=') == 3 && haystack.find('=', 4) == 16 && haystack.find('#') == UserDefined::String::npos);
+    assert(haystack.find("key") == 0 && haystack.find("key", 1) == 24 && haystack.find(UserDefined::String("thing")) == 17);
+    assert(haystack.find("") == 0 && haystack.find("", 33) == 33 && haystack.find("", 34) == UserDefined::String::npos);
+    assert(haystack.rfind('=') == 27 && haystack.rfind('=', 26) == 16 && haystack.rfind('#') == UserDefined::String::npos);
+    assert(haystack.rfind("key") == 24 && haystack.rfind("key", 23) == 0 && haystack.rfind("missing") == UserDefined::String::npos);
+    assert(haystack.find_first_of(";=") == 3 && haystack.find_first_of(";", 10) == 22 && haystack.find_first_of("#!") == UserDefined::String::npos);
+    assert(haystack.count('=') == 3 && haystack.count(';') == 2 && UserDefined::String().count('x') == 0);
+
+    // Test the hash is cached, follows the characters and is reset by modification
+    UserDefined::String h1("The quick brown fox jumps over the lazy dog");
+    UserDefined::String h2(h1);
+    std::cout << "Hash: str = \"" << h1 << "\", hash = " << h1.hash() << std::endl;
+    assert(h1.hash() == h2.hash() && h1.hash() == std::hash<UserDefined::String>()(h2));
+    assert(h1.hash() == UserDefined::String(std::string(h1.c_str()).c_str()).hash());
+    std::size_t originalHash = h1.hash();
+    h1 += "!";
+    assert(h1.hash() != originalHash && !(h1 == h2));
+    h1 = h2;
+    assert(h1.hash() == originalHash && h1 == h2);
+    UserDefined::String h3(std::move(h1));
+    assert(h3.hash() == originalHash && h1.hash() == UserDefined::String().hash());
+    assert(UserDefined::String("a").hash() != UserDefined::String("b").hash());
+    assert(UserDefined::String("abcdefgh").hash() != UserDefined::String("abcdefgi").hash());
+    std::string hashInput(200, 'h');
+    std::vector<std::size_t> prefixHashes;
+    for (std::size_t length = 0; length <= hashInput.size(); ++length)
+    {
+        // Every length takes one of the short, 16-byte or 48-byte paths; the address must not matter.
+        std::uint64_t prefixHash = UserDefined::hashBytes(hashInput.data(), length);
+        assert(prefixHash == UserDefined::hashBytes(std::string(hashInput, 0, length).data(), length));
+        prefixHashes.push_back(prefixHash);
+    }
+    std::sort(prefixHashes.begin(), prefixHashes.end());
+    assert(std::unique(prefixHashes.begin(), prefixHashes.end()) == prefixHashes.end());
+
+    // Test Strings as unordered_map keys
+    std::unordered_map<UserDefined::String, int> wordCounts;
+    for (const char* word : { "alpha", "beta", "alpha", "a key that is too long for the inline buffer", "alpha" })
+    {
+        wordCounts[word]++;
+    }
+    assert(wordCounts.size() == 3 && wordCounts["alpha"] == 3 && wordCounts["beta"] == 1);
+    assert(wordCounts.count("a key that is too long for the inline buffer") == 1 && wordCounts.count("gamma") == 0);
+
+    // Test ordering and compare
+    assert(UserDefined::String("apple").compare("apricot") < 0);
+    assert(UserDefined::String("apricot").compare("apple") > 0);
+    assert(UserDefined::String("apple").compare("apple") == 0);
+    assert(UserDefined::String("app").compare("apple") < 0 && UserDefined::String("").compare("") == 0);
+    assert(UserDefined::String("\xff").compare("a") > 0);     // Characters compare as unsigned
+    UserDefined::String longPrefix(std::string(100, 'k').c_str());
+    UserDefined::String longLater(std::string(99, 'k').append("l").c_str());
+    assert(longPrefix < longLater && longPrefix <= longLater && longLater > longPrefix && longLater >= longPrefix);
+    assert(longPrefix <= longPrefix && longPrefix >= longPrefix && !(longPrefix < longPrefix));
+    assert(longPrefix < "l" && UserDefined::StringView("k") < longPrefix);
+    std::map<UserDefined::String, int> ordered;
+    for (const char* word : { "pear", "apple", "a key that is too long for the inline buffer", "fig", "apple" })
+    {
+        ordered[word]++;
+    }
+    std::vector<UserDefined::String> keys;
+    for (const auto& entry : ordered)
+    {
+        keys.push_back(entry.first);
+    }
+    assert(keys.size() == 4 && keys[0] == "a key that is too long for the inline buffer" && keys[1] == "apple" && keys[3] == "pear");
+    assert(ordered["apple"] == 2);
+    std::vector<std::string> words = { "kiwi", "banana", "", "band", "bandana", "\x80high", "ban" };
+    std::vector<UserDefined::String> strings(words.begin(), words.end());
+    std::sort(words.begin(), words.end());
+    std::sort(strings.begin(), strings.end());
+    for (std::size_t i = 0; i < words.size(); ++i)
+    {
+        assert(strings[i] == words[i].c_str());
+    }
+
+    // Test swap between inline and heap strings and across resources
+    UserDefined::String shortSwap("short");
+    UserDefined::String longSwap("a string that is too long for the inline buffer");
+    std::size_t longHash = longSwap.hash();
+    swap(shortSwap, longSwap);
+    assert(shortSwap == "a string that is too long for the inline buffer" && longSwap == "short");
+    assert(shortSwap.hash() == longHash);
+    longSwap.swap(longSwap);
+    assert(longSwap == "short");
+    UserDefined::MonotonicArena swapArena;
+    UserDefined::String arenaSwap("an arena string that is too long for the inline buffer", &swapArena);
+    arenaSwap.swap(shortSwap);
+    assert(arenaSwap == "a string that is too long for the inline buffer" && arenaSwap.memoryResource() == &swapArena);
+    assert(shortSwap == "an arena string that is too long for the inline buffer" && shortSwap.memoryResource() == UserDefined::defaultResource());
+
+    // Test adopting and releasing buffers without copying
+    std::unique_ptr<char[]> readBuffer(new char[64]);
+    std::memcpy(readBuffer.get(), "bytes filled in by a read() call, adopted", 41);
+    const char* readData = readBuffer.get();
+    UserDefined::String adopted(std::move(readBuffer), 41, 63);
+    assert(adopted.c_str() == readData && adopted.capacity() == 63);
+    assert(adopted == "bytes filled in by a read() call, adopted" && adopted.memoryResource() == UserDefined::newDeleteResource());
+    adopted += " and appended in place";
+    assert(adopted.c_str() == readData);
+    UserDefined::String::OwnedBuffer released = adopted.release();
+    assert(released.data.get() == readData && released.length == 63 && released.capacity == 63 && released.data[63] == '\0');
+    assert(adopted.length() == 0 && adopted == "");
+    UserDefined::String readopted(std::move(released));
+    assert(readopted.c_str() == readData && readopted.length() == 63 && !released.data);
+
+    UserDefined::String shortRelease("short");
+    UserDefined::String::OwnedBuffer shortBuffer = shortRelease.release();
+    assert(shortBuffer.length == 5 && shortBuffer.capacity == 5 && std::strcmp(shortBuffer.data.get(), "short") == 0);
+    UserDefined::MonotonicArena releaseArena;
+    UserDefined::String arenaRelease("an arena string that is too long for the inline buffer", &releaseArena);
+    UserDefined::String::OwnedBuffer arenaBuffer = arenaRelease.release();
+    assert(arenaBuffer.length == 54 && std::strcmp(arenaBuffer.data.get(), "an arena string that is too long for the inline buffer") == 0);
+    assert(arenaRelease.memoryResource() == &releaseArena);
+
+    // Test replace in place, growing, at the ends and with part of the string itself
+    UserDefined::String replaced("Hello, {name}!");
+    replaced.replace(7, 6, "Ada");
+    printTestOutput("replace", replaced);
+    assert(replaced == "Hello, Ada!" && replaced.capacity() == 23);
+    replaced.replace(7, 3, "a name long enough to move the string to the heap");
+    assert(replaced == "Hello, a name long enough to move the string to the heap!");
+    replaced.replace(0, 5, "");
+    replaced.replace(replaced.length(), 100, " Bye.");
+    assert(replaced == ", a name long enough to move the string to the heap! Bye.");
+    UserDefined::String selfReplaced("abcdef");
+    selfReplaced.replace(1, 2, UserDefined::StringView(selfReplaced).substr(2));
+    assert(selfReplaced == "acdefdef");
+
+    // Test replace_all shrinking, growing and with overlapping candidates
+    UserDefined::String templateText("{x} + {x} = 2{x}");
+    assert(templateText.replace_all("{x}", "y") == 3 && templateText == "y + y = 2y");
+    assert(templateText.replace_all("y", "{long placeholder}") == 3 && templateText == "{long placeholder} + {long placeholder} = 2{long placeholder}");
+    assert(templateText.replace_all("missing", "anything that is long") == 0);
+    assert(templateText.replace_all("", "x") == 0);
+    UserDefined::String overlapping("aaaaa");
+    assert(overlapping.replace_all("aa", "b") == 2 && overlapping == "bba");
+    UserDefined::String shortGrowth("a-b");
+    assert(shortGrowth.replace_all("-", "--") == 1 && shortGrowth == "a--b");
+    UserDefined::String selfNeedle("xyxy");
+    assert(selfNeedle.replace_all(UserDefined::StringView(selfNeedle).substr(0, 2), selfNeedle) == 2 && selfNeedle == "xyxyxyxy");
+    assert(UserDefined::StringView("abababa").count("aba") == 2);
+    UserDefined::String roomyText("aaa,aaa,a");
+    roomyText.reserve(100);
+    const char* roomyData = roomyText.c_str();
+    assert(roomyText.replace_all("aa", "[aa]") == 2 && roomyText == "[aa]a,[aa]a,a");
+    assert(roomyText.c_str() == roomyData && roomyText.capacity() == 100);
+
+    std::mt19937 replaceRandom(23);
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::string text(replaceRandom() % 80, ' ');
+        for (char& ch : text)
+        {
+            ch = static_cast<char>('a' + replaceRandom() % 3);
+        }
+        std::string needle(1 + replaceRandom() % 3, ' ');
+        for (char& ch : needle)
+        {
+            ch = static_cast<char>('a' + replaceRandom() % 3);
+        }
+        std::string replacement(replaceRandom() % 6, 'R');
+
+        UserDefined::String subject(text.c_str());
+        if (round % 2 == 0)
+        {
+            subject.reserve(text.size() * 3);
+        }
+        subject.replace_all(needle.c_str(), replacement.c_str());
+        assert(subject == expectedReplaceAll(text, needle, replacement).c_str());
+        assert(subject.length() == std::strlen(subject.c_str()));
+    }
+
+    // Test case conversion in place and into copies, leaving non-letters and UTF-8 alone
+    UserDefined::String header("Content-Type: Text/HTML; charset=UTF-8 \xC3\x84 [@`{]");
+    UserDefined::String lowered = UserDefined::toLower(header);
+    printTestOutput("toLower", lowered);
+    assert(lowered == "content-type: text/html; charset=utf-8 \xC3\x84 [@`{]");
+    assert(UserDefined::toUpper(header) == "CONTENT-TYPE: TEXT/HTML; CHARSET=UTF-8 \xC3\x84 [@`{]");
+    std::size_t headerHash = header.hash();
+    assert(header.toUpper().toLower() == lowered && header.hash() != headerHash && header.hash() == lowered.hash());
+    assert(UserDefined::toLower("").length() == 0 && UserDefined::toUpper("mIxEd") == "MIXED");
+
+    // Test comparing and hashing ignoring case
+    assert(UserDefined::String("Accept-Encoding").equalsIgnoreCase("ACCEPT-encoding"));
+    assert(!UserDefined::String("Accept-Encoding").equalsIgnoreCase("Accept-Encodin"));
+    assert(!UserDefined::String("[").equalsIgnoreCase("{") && !UserDefined::String("@").equalsIgnoreCase("`"));
+    assert(!UserDefined::StringView("\xC3\x84").equalsIgnoreCase("\xC3\xA4"));
+    for (std::size_t length : { 0, 1, 3, 4, 8, 16, 17, 48, 49, 100 })
+    {
+        std::string mixedCase;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            mixedCase.push_back(static_cast<char>(i % 3 == 0 ? 'A' + i % 26 : i % 3 == 1 ? 'a' + i % 26 : '0' + i % 10));
+        }
+        UserDefined::String key(mixedCase.c_str());
+        assert(key.hashIgnoreCase() == UserDefined::toLower(key).hash());
+        assert(key.hashIgnoreCase() == UserDefined::toUpper(key).hashIgnoreCase());
+    }
+
+    std::unordered_map<UserDefined::String, int, UserDefined::CaseInsensitiveHash, UserDefined::CaseInsensitiveEqual> headers;
+    headers["Content-Length"] = 42;
+    headers["HOST"] = 1;
+    assert(headers.find("content-length") != headers.end() && headers.find("content-length")->second == 42);
+    assert(headers.count("Host") == 1 && headers.count("Hosts") == 0);
+    headers["host"] = 2;
+    assert(headers.size() == 2 && headers["Host"] == 2);
+
     return 0;
 }
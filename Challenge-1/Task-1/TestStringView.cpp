@@ -0,0 +1,106 @@
+/**************************************************************************************************
+ * @file TestStringView.cpp
+ *
+ * @brief This file is used to test the UserDefined::StringView class.
+ **************************************************************************************************/
+
+#include "String.hpp"
+#include <cassert>
+#include <unordered_map>
+
+namespace
+{
+    void printTestOutput(const char* testName, UserDefined::StringView view)
+    {
+        std::cout << testName << ": view = \"" << view << "\", length = " << view.length() << std::endl;
+    }
+
+    /**
+     * @brief Takes a view by value, to check the implicit conversions.
+     */
+    std::size_t viewLength(UserDefined::StringView view)
+    {
+        return view.length();
+    }
+}
+
+int main() {
+    // Test default constructor
+    UserDefined::StringView v1;
+    printTestOutput("Default constructor", v1);
+    assert(v1.empty() && v1.length() == 0);
+
+    // Test implicit construction from a C-string, a String and a std::string
+    UserDefined::String source("GET /index.html HTTP/1.1");
+    UserDefined::StringView v2 = source;
+    printTestOutput("From String", v2);
+    assert(v2.data() == source.c_str() && v2.length() == source.length());
+    assert(viewLength("abc") == 3 && viewLength(source) == 24 && viewLength(std::string("abcd")) == 4);
+
+    // Test substr slices without copying
+    UserDefined::StringView method = v2.substr(0, v2.find(' '));
+    UserDefined::StringView path = v2.substr(4, v2.find(' ', 4) - 4);
+    UserDefined::StringView version = v2.substr(v2.rfind(' ') + 1);
+    printTestOutput("substr", path);
+    assert(method == "GET" && path == "/index.html" && version == "HTTP/1.1");
+    assert(path.data() == source.c_str() + 4);
+    assert(v2.substr(24).empty() && v2.substr(20, 100) == "/1.1");
+
+    // Test remove_prefix and remove_suffix
+    UserDefined::StringView v3("  padded  ");
+    while (v3.starts_with(' '))
+    {
+        v3.remove_prefix(1);
+    }
+    while (v3.ends_with(' '))
+    {
+        v3.remove_suffix(1);
+    }
+    printTestOutput("Trimmed", v3);
+    assert(v3 == "padded");
+
+    // Test starts_with and ends_with
+    assert(v2.starts_with("GET ") && !v2.starts_with("POST") && v2.starts_with(""));
+    assert(v2.ends_with("1.1") && !v2.ends_with("2.0") && !UserDefined::StringView("ab").ends_with("abc"));
+    assert(!v1.starts_with('a') && !v1.ends_with('a'));
+
+    // Test comparison, including embedded null characters
+    const char withNull[] = { 'a', '\0', 'b' };
+    assert(UserDefined::StringView(withNull, 3) != UserDefined::StringView("a"));
+    assert(UserDefined::StringView(withNull, 3) == UserDefined::StringView(withNull, 3));
+    assert(UserDefined::StringView("abc") != "abd" && UserDefined::StringView("abc") != "ab");
+
+    // Test comparing Strings with views in both orders, without converting the view
+    UserDefined::String compared("/index.html");
+    assert(compared == path && path == compared && !(compared != path) && !(path != compared));
+    assert(compared != v2 && v2 != compared && compared != UserDefined::StringView());
+    assert(UserDefined::String() == UserDefined::StringView() && UserDefined::StringView("") == UserDefined::String());
+    assert(compared == "/index.html" && "/index.html" == compared && compared != "/index.htm" && "/index" != compared);
+    assert(UserDefined::String(UserDefined::StringView(withNull, 3)) == UserDefined::StringView(withNull, 3));
+    assert(UserDefined::String(UserDefined::StringView(withNull, 3)) != "a");
+
+    // Test search functions
+    assert(v2.find("HTTP") == 16 && v2.find('/') == 4 && v2.find('#') == UserDefined::StringView::npos);
+    assert(v2.rfind('/') == 20 && v2.find_first_of(" /") == 3 && v2.count('/') == 2);
+    assert(path.find('.') == 6 && path.find(".", 7) == UserDefined::StringView::npos);
+
+    // Test String construction, search and operator+ with views
+    UserDefined::String copied(path);
+    printTestOutput("String from view", copied);
+    assert(copied == UserDefined::String("/index.html") && copied.c_str() != path.data());
+    assert(source.find(path) == 4 && source.find_first_of(UserDefined::StringView("/.")) == 4);
+    UserDefined::String joined = method + UserDefined::StringView(" ") + path;
+    printTestOutput("operator+ with views", joined);
+    assert(joined == UserDefined::String("GET /index.html"));
+    UserDefined::String prefixed = "[" + version + "]";
+    assert(prefixed == UserDefined::String("[HTTP/1.1]"));
+
+    // Test views hash like the Strings they refer to
+    assert(std::hash<UserDefined::StringView>()(path) == std::hash<UserDefined::String>()(copied));
+    std::unordered_map<UserDefined::StringView, int> fieldIndex;
+    fieldIndex[method] = 0;
+    fieldIndex[path] = 1;
+    assert(fieldIndex.count("/index.html") == 1 && fieldIndex["GET"] == 0);
+
+    return 0;
+}
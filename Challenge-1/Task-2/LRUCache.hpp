@@ -306,7 +306,7 @@ public:
             // Add the element to element size map
             mElementSizeMap.insert({size, key});
 
-            LOG("Updated element with key: " + std::to_string(key));
+            LOG("Updated element with key: " + Utility::toString(key));
         }
         if (mTotalSize > mMaxSizeHardLimit)
         {
@@ -350,7 +350,7 @@ public:
 
                         leastRecentlyUsedElement = mElementMap[cacheElement->getPrimaryKey()];
 
-                        LOG("Element with key (" + std::to_string(leastRecentlyUsedElement->getPrimaryKey()) + ") removed based on time threshold and max size.");
+                        LOG("Element with key (" + Utility::toString(leastRecentlyUsedElement->getPrimaryKey()) + ") removed based on time threshold and max size.");
                     }
                 }
                 else
@@ -367,7 +367,7 @@ public:
                         mElementSizeMap.erase(it);
                     }
 
-                    LOG("Element with key (" + std::to_string(leastRecentlyUsedElement->getPrimaryKey()) + ") removed based on LRU policy");
+                    LOG("Element with key (" + Utility::toString(leastRecentlyUsedElement->getPrimaryKey()) + ") removed based on LRU policy");
                 }
 
                 mElementMap.erase(leastRecentlyUsedElement->getPrimaryKey());
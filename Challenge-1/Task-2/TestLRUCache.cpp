@@ -9,6 +9,7 @@
 
 #include "LRUCache.hpp"
 #include "Utility.hpp"
+#include "../Task-1/String.hpp"
 
 namespace 
 {
@@ -158,5 +159,33 @@ int main()
 
     printElements(elements);
 
+    {
+        // String keys are supported as well (the cache logs keys through their stream operator).
+        LRUCache<TestElement, std::string> stringKeyCache(60, 100, 5);
+        auto element = std::make_shared<TestElement>("String key element", 100, 10);
+
+        stringKeyCache.updateElement(element, "string-key", element->getSize());
+
+        assert(stringKeyCache.getElement("string-key") == element);
+        assert(stringKeyCache.getElement("missing-key") == nullptr);
+        stringKeyCache.dumpCache();
+    }
+
+    {
+        // UserDefined::String keys work too, through their ordering, != and stream operators.
+        LRUCache<TestElement, UserDefined::String> userStringKeyCache(60, 100, 5);
+        auto shortKeyElement = std::make_shared<TestElement>("Short String key element", 101, 10);
+        auto longKeyElement = std::make_shared<TestElement>("Long String key element", 102, 20);
+        UserDefined::String longKey("a key that is too long for the inline buffer");
+
+        userStringKeyCache.updateElement(shortKeyElement, UserDefined::String("short-key"), shortKeyElement->getSize());
+        userStringKeyCache.updateElement(longKeyElement, longKey, longKeyElement->getSize());
+
+        assert(userStringKeyCache.getElement(UserDefined::String("short-key")) == shortKeyElement);
+        assert(userStringKeyCache.getElement(UserDefined::String(longKey.c_str())) == longKeyElement);
+        assert(userStringKeyCache.getElement(UserDefined::String("missing-key")) == nullptr);
+        userStringKeyCache.dumpCache();
+    }
+
     return 0;
 }
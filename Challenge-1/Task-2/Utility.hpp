@@ -55,6 +55,22 @@ namespace Utility
         std::cout << "[" << getCurrentTime() << "][" << fileName << "][" << functionName << "] " << message << std::endl;
     }
 
+    /**
+     * @brief Converts a value to a string for logging, using its stream output operator.
+     *
+     * Unlike std::to_string, this also works for keys that are strings or user-defined types.
+     *
+     * @param value The value to convert.
+     * @return The text the value prints as.
+     */
+    template <typename T>
+    std::string toString(const T& value)
+    {
+        std::ostringstream ss;
+        ss << value;
+        return ss.str();
+    }
+
     #define LOG(message) Utility::log(__FILE__, __func__, (message))
 };
 